@@ -0,0 +1,855 @@
+/**
+ * @file    hal_mock.c
+ * @brief   Host HAL mock: registers in RAM, virtual time, recorded calls
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "hal_mock.h"
+#include "main.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Peripheral instances
+// ============================================================================
+
+GPIO_TypeDef    halmock_gpio[8];
+TIM_TypeDef     halmock_tim[12];
+USART_TypeDef   halmock_usart[7];
+EXTI_TypeDef    halmock_exti;
+RCC_TypeDef     halmock_rcc;
+DWT_Type        halmock_dwt;
+CoreDebug_Type  halmock_coredebug;
+SCB_Type        halmock_scb;
+SysTick_Type    halmock_systick;
+
+uint32_t SystemCoreClock = HSI_VALUE;
+uint32_t halmock_flash_latency = FLASH_LATENCY_0;
+uint32_t halmock_voltage_scale = PWR_REGULATOR_VOLTAGE_SCALE1;
+
+// ============================================================================
+// Mock state
+// ============================================================================
+
+static uint64_t now_us;
+static volatile uint32_t tick_ms;
+static uint32_t primask;
+static int16_t active_irq = -1;             // Handler running, -1 = thread mode
+
+static uint64_t irq_enabled;
+static uint64_t irq_pending;
+static uint8_t irq_priority[HALMOCK_IRQ_COUNT];
+
+static uint32_t tim_prescale[12];           // Timer clocks since the last count
+static uint32_t cycles_frac;                // DWT: SystemCoreClock remainder
+
+static GPIO_TypeDef *exti_port[16];         // Port selected for each EXTI line
+
+static UART_HandleTypeDef *uart_handle[7];
+static uint32_t uart_overruns[7];
+static uint32_t uart_tx_timeouts[7];
+
+static HalMock_TxHook tx_hook;
+static HalMock_StepHook step_hooks[HALMOCK_STEP_HOOKS];
+static uint8_t step_hook_count;
+static bool uart_timing;
+static uint32_t uart_baud;                  // 0 = from BRR
+
+/* RCC: current PLL output and source selection */
+static uint32_t pll_out_hz;
+static uint32_t sysclk_source = RCC_SYSCLKSOURCE_HSI;
+static uint32_t sysclk_hz = HSI_VALUE;
+
+/* Call log ring and per-function totals */
+static HalMock_Call call_log[HALMOCK_CALL_LOG_SIZE];
+static uint32_t call_total;
+static struct { const char *fn; uint32_t count; } call_counts[64];
+static uint8_t call_count_n;
+
+static void HalMock_Record(const char *fn, uintptr_t a0, uintptr_t a1, uintptr_t a2)
+{
+    HalMock_Call *c = &call_log[call_total % HALMOCK_CALL_LOG_SIZE];
+    c->fn = fn;
+    c->a0 = (uint32_t)a0;
+    c->a1 = (uint32_t)a1;
+    c->a2 = (uint32_t)a2;
+    c->time_us = now_us;
+    call_total++;
+
+    for (uint8_t i = 0; i < call_count_n; i++) {
+        if (call_counts[i].fn == fn || strcmp(call_counts[i].fn, fn) == 0) {
+            call_counts[i].count++;
+            return;
+        }
+    }
+    if (call_count_n < sizeof(call_counts) / sizeof(call_counts[0])) {
+        call_counts[call_count_n].fn = fn;
+        call_counts[call_count_n].count = 1;
+        call_count_n++;
+    }
+}
+
+#define RECORD(a0, a1, a2)  HalMock_Record(__func__, (uintptr_t)(a0), (uintptr_t)(a1), (uintptr_t)(a2))
+
+// ============================================================================
+// Interrupts
+// ============================================================================
+
+/* Vectors the firmware may leave undefined on the host */
+__attribute__((weak)) void SysTick_Handler(void) { HAL_IncTick(); }
+__attribute__((weak)) void USART1_IRQHandler(void) { HAL_UART_IRQHandler(uart_handle[1]); }
+__attribute__((weak)) void EXTI0_IRQHandler(void) {}
+__attribute__((weak)) void EXTI1_IRQHandler(void) {}
+__attribute__((weak)) void EXTI2_IRQHandler(void) {}
+__attribute__((weak)) void EXTI3_IRQHandler(void) {}
+__attribute__((weak)) void EXTI4_IRQHandler(void) {}
+__attribute__((weak)) void EXTI9_5_IRQHandler(void) {}
+__attribute__((weak)) void EXTI15_10_IRQHandler(void) {}
+__attribute__((weak)) void TIM1_BRK_TIM9_IRQHandler(void) {}
+__attribute__((weak)) void TIM1_UP_TIM10_IRQHandler(void) {}
+__attribute__((weak)) void TIM1_TRG_COM_TIM11_IRQHandler(void) {}
+__attribute__((weak)) void TIM2_IRQHandler(void) {}
+__attribute__((weak)) void TIM3_IRQHandler(void) {}
+__attribute__((weak)) void TIM4_IRQHandler(void) {}
+__attribute__((weak)) void TIM5_IRQHandler(void) {}
+
+/* SysTick takes slot 0 of the pending mask (its IRQn is negative) */
+#define IRQ_SLOT(irq)   ((irq) < 0 ? 0U : (uint32_t)(irq) + 1U)
+
+/* SysTick is a core exception, always enabled (no NVIC bit) */
+#define IRQ_SYSTICK_BIT (1ULL << IRQ_SLOT(SysTick_IRQn))
+
+static void HalMock_Vector(uint32_t slot)
+{
+    switch ((int)slot - 1) {
+    case SysTick_IRQn:              SysTick_Handler(); break;
+    case EXTI0_IRQn:                EXTI0_IRQHandler(); break;
+    case EXTI1_IRQn:                EXTI1_IRQHandler(); break;
+    case EXTI2_IRQn:                EXTI2_IRQHandler(); break;
+    case EXTI3_IRQn:                EXTI3_IRQHandler(); break;
+    case EXTI4_IRQn:                EXTI4_IRQHandler(); break;
+    case EXTI9_5_IRQn:              EXTI9_5_IRQHandler(); break;
+    case EXTI15_10_IRQn:            EXTI15_10_IRQHandler(); break;
+    case TIM1_BRK_TIM9_IRQn:        TIM1_BRK_TIM9_IRQHandler(); break;
+    case TIM1_UP_TIM10_IRQn:        TIM1_UP_TIM10_IRQHandler(); break;
+    case TIM1_TRG_COM_TIM11_IRQn:   TIM1_TRG_COM_TIM11_IRQHandler(); break;
+    case TIM2_IRQn:                 TIM2_IRQHandler(); break;
+    case TIM3_IRQn:                 TIM3_IRQHandler(); break;
+    case TIM4_IRQn:                 TIM4_IRQHandler(); break;
+    case TIM5_IRQn:                 TIM5_IRQHandler(); break;
+    case USART1_IRQn:               USART1_IRQHandler(); break;
+    default: break;
+    }
+}
+
+/**
+ * @brief Run pending handlers, most urgent first
+ * Handlers run to completion (no preemption); an interrupt raised inside a
+ * handler is served after it returns.
+ */
+static void HalMock_Dispatch(void)
+{
+    while (primask == 0 && active_irq < 0) {
+        uint64_t ready = irq_pending & (irq_enabled | IRQ_SYSTICK_BIT);
+        if (ready == 0) return;
+
+        uint32_t best = 64;
+        for (uint32_t s = 0; s < HALMOCK_IRQ_COUNT; s++) {
+            if ((ready & (1ULL << s)) &&
+                (best == 64 || irq_priority[s] < irq_priority[best])) {
+                best = s;
+            }
+        }
+
+        irq_pending &= ~(1ULL << best);
+        active_irq = (int16_t)best;
+        HalMock_Vector(best);
+        active_irq = -1;
+    }
+}
+
+void HalMock_RaiseIrq(IRQn_Type irq)
+{
+    irq_pending |= 1ULL << IRQ_SLOT(irq);
+    HalMock_Dispatch();
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    RECORD(IRQn, PreemptPriority, SubPriority);
+    irq_priority[IRQ_SLOT(IRQn)] = (uint8_t)(PreemptPriority << 4 | SubPriority);
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    RECORD(IRQn, 0, 0);
+    irq_enabled |= 1ULL << IRQ_SLOT(IRQn);
+    HalMock_Dispatch();
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    RECORD(IRQn, 0, 0);
+    irq_enabled &= ~(1ULL << IRQ_SLOT(IRQn));
+}
+
+void __disable_irq(void)
+{
+    primask = 1;
+}
+
+void __enable_irq(void)
+{
+    primask = 0;
+    HalMock_Dispatch();
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return primask;
+}
+
+void __set_PRIMASK(uint32_t priMask)
+{
+    primask = priMask & 1U;
+    HalMock_Dispatch();
+}
+
+uint32_t __get_MSP(void)
+{
+    return 0;
+}
+
+uint32_t __get_IPSR(void)
+{
+    return active_irq < 0 ? 0U : (uint32_t)active_irq + 15U;
+}
+
+/* WFI returns on a pending interrupt even with PRIMASK set */
+void __WFI(void)
+{
+    HalMock_AdvanceToInterrupt(1000000U);
+}
+
+// ============================================================================
+// Virtual time
+// ============================================================================
+
+static IRQn_Type HalMock_TimerIrq(uint32_t n)
+{
+    switch (n) {
+    case 1:  return TIM1_UP_TIM10_IRQn;
+    case 2:  return TIM2_IRQn;
+    case 3:  return TIM3_IRQn;
+    case 4:  return TIM4_IRQn;
+    case 5:  return TIM5_IRQn;
+    case 9:  return TIM1_BRK_TIM9_IRQn;
+    case 10: return TIM1_UP_TIM10_IRQn;
+    case 11: return TIM1_TRG_COM_TIM11_IRQn;
+    default: return SysTick_IRQn;
+    }
+}
+
+/* Timer kernel clock: PCLK, doubled when the APB prescaler is not 1 */
+static uint32_t HalMock_TimerClock(uint32_t n)
+{
+    bool apb2 = (n == 1 || n >= 9);
+    uint32_t ppre = apb2 ? (RCC->CFGR & RCC_CFGR_PPRE2) : (RCC->CFGR & RCC_CFGR_PPRE1);
+    uint32_t pclk = apb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    return (ppre == 0) ? pclk : 2U * pclk;
+}
+
+static void HalMock_Step(void)
+{
+    now_us++;
+    for (uint8_t i = 0; i < step_hook_count; i++) {
+        step_hooks[i](now_us);
+    }
+
+    /* Up-counting timers with PSC and ARR applied immediately */
+    for (uint32_t n = 1; n < 12; n++) {
+        TIM_TypeDef *tim = &halmock_tim[n];
+        if ((tim->CR1 & TIM_CR1_CEN) == 0) continue;
+
+        tim_prescale[n] += HalMock_TimerClock(n) / 1000000U;
+        uint32_t div = tim->PSC + 1U;
+        while (tim_prescale[n] >= div) {
+            tim_prescale[n] -= div;
+            if (tim->CNT >= tim->ARR) {
+                tim->CNT = 0;
+                tim->SR |= TIM_SR_UIF;
+                if (tim->DIER & TIM_DIER_UIE) {
+                    irq_pending |= 1ULL << IRQ_SLOT(HalMock_TimerIrq(n));
+                }
+            } else {
+                tim->CNT++;
+            }
+        }
+    }
+
+    if ((CoreDebug->DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        cycles_frac += SystemCoreClock % 1000000U;
+        DWT->CYCCNT += SystemCoreClock / 1000000U + cycles_frac / 1000000U;
+        cycles_frac %= 1000000U;
+    }
+
+    /* SysTick: 1 kHz, VAL counts down through the millisecond */
+    uint32_t us_in_ms = (uint32_t)(now_us % 1000U);
+    SysTick->LOAD = SystemCoreClock / 1000U - 1U;
+    SysTick->VAL = (uint32_t)((uint64_t)(1000U - us_in_ms) * SystemCoreClock / 1000000U) % (SysTick->LOAD + 1U);
+    if (us_in_ms == 0) {
+        irq_pending |= IRQ_SYSTICK_BIT;
+    }
+
+    HalMock_Dispatch();
+}
+
+uint64_t HalMock_NowUs(void)
+{
+    return now_us;
+}
+
+void HalMock_AdvanceUs(uint64_t us)
+{
+    while (us-- > 0) {
+        HalMock_Step();
+    }
+}
+
+uint32_t HalMock_AdvanceToInterrupt(uint32_t max_us)
+{
+    uint32_t us = 0;
+    while (us < max_us && (irq_pending & (irq_enabled | IRQ_SYSTICK_BIT)) == 0) {
+        HalMock_Step();
+        us++;
+    }
+    return us;
+}
+
+bool HalMock_AddStepHook(HalMock_StepHook hook)
+{
+    if (hook == NULL || step_hook_count >= HALMOCK_STEP_HOOKS) return false;
+    step_hooks[step_hook_count++] = hook;
+    return true;
+}
+
+// ============================================================================
+// HAL core, RCC, PWR, FLASH
+// ============================================================================
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+    RECORD(0, 0, 0);
+    HAL_NVIC_SetPriority(SysTick_IRQn, 15, 0);
+    return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return tick_ms;
+}
+
+void HAL_IncTick(void)
+{
+    tick_ms++;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    RECORD(Delay, 0, 0);
+    uint32_t start = tick_ms;
+    while (tick_ms - start < Delay + 1U) {
+        HalMock_Step();
+    }
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+    RECORD(RCC_OscInitStruct->OscillatorType, RCC_OscInitStruct->PLL.PLLState,
+           RCC_OscInitStruct->PLL.PLLN);
+
+    const RCC_PLLInitTypeDef *pll = &RCC_OscInitStruct->PLL;
+    if (pll->PLLState == RCC_PLL_ON) {
+        /* PLL may not be reconfigured while it drives SYSCLK */
+        if (sysclk_source == RCC_SYSCLKSOURCE_PLLCLK) return HAL_ERROR;
+        uint32_t in = (pll->PLLSource == RCC_PLLSOURCE_HSE) ? HSE_VALUE : HSI_VALUE;
+        if (pll->PLLM == 0 || pll->PLLP == 0) return HAL_ERROR;
+        /* HAL waits for PLLRDY; the rest of the chip keeps running meanwhile */
+        for (uint32_t i = 0; i < HALMOCK_PLL_LOCK_US; i++) {
+            HalMock_Step();
+        }
+        pll_out_hz = (uint32_t)((uint64_t)in / pll->PLLM * pll->PLLN / pll->PLLP);
+    } else if (pll->PLLState == RCC_PLL_OFF) {
+        if (sysclk_source == RCC_SYSCLKSOURCE_PLLCLK) return HAL_ERROR;
+        pll_out_hz = 0;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+    RECORD(RCC_ClkInitStruct->SYSCLKSource, RCC_ClkInitStruct->APB1CLKDivider, FLatency);
+
+    uint32_t hz;
+    switch (RCC_ClkInitStruct->SYSCLKSource) {
+    case RCC_SYSCLKSOURCE_HSE:    hz = HSE_VALUE; break;
+    case RCC_SYSCLKSOURCE_PLLCLK: hz = pll_out_hz; break;
+    default:                      hz = HSI_VALUE; break;
+    }
+    if (hz == 0) return HAL_ERROR;
+
+    sysclk_source = RCC_ClkInitStruct->SYSCLKSource;
+    sysclk_hz = hz;
+    halmock_flash_latency = FLatency;
+    RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2)) |
+                RCC_ClkInitStruct->APB1CLKDivider | (RCC_ClkInitStruct->APB2CLKDivider << 3);
+    SystemCoreClock = sysclk_hz;
+    return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetSysClockFreq(void)
+{
+    return sysclk_hz;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+    return SystemCoreClock;
+}
+
+/* PPRE encoding: 0xx = /1, 100 = /2, 101 = /4, 110 = /8, 111 = /16 */
+static uint32_t HalMock_ApbShift(uint32_t ppre)
+{
+    return (ppre & 0x4U) ? (ppre & 0x3U) + 1U : 0U;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return SystemCoreClock >> HalMock_ApbShift((RCC->CFGR >> 10) & 0x7U);
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+    return SystemCoreClock >> HalMock_ApbShift((RCC->CFGR >> 13) & 0x7U);
+}
+
+// ============================================================================
+// GPIO / EXTI
+// ============================================================================
+
+static IRQn_Type HalMock_ExtiIrq(uint32_t line)
+{
+    if (line <= 4) return (IRQn_Type)(EXTI0_IRQn + (int)line);
+    return (line <= 9) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    RECORD(GPIOx, GPIO_Init->Pin, GPIO_Init->Mode);
+
+    for (uint32_t line = 0; line < 16; line++) {
+        uint32_t bit = 1UL << line;
+        if ((GPIO_Init->Pin & bit) == 0) continue;
+
+        GPIOx->MODER = (GPIOx->MODER & ~(3UL << (line * 2))) | ((GPIO_Init->Mode & 3UL) << (line * 2));
+        GPIOx->PUPDR = (GPIOx->PUPDR & ~(3UL << (line * 2))) | ((GPIO_Init->Pull & 3UL) << (line * 2));
+
+        /* Inputs idle at their pull level */
+        if ((GPIO_Init->Mode & 3UL) == GPIO_MODE_INPUT) {
+            if (GPIO_Init->Pull == GPIO_PULLUP) GPIOx->IDR |= bit;
+            if (GPIO_Init->Pull == GPIO_PULLDOWN) GPIOx->IDR &= ~bit;
+        }
+
+        if (GPIO_Init->Mode & 0x10000000U) {
+            exti_port[line] = GPIOx;
+            EXTI->IMR |= bit;
+            if (GPIO_Init->Mode & 0x00100000U) EXTI->RTSR |= bit; else EXTI->RTSR &= ~bit;
+            if (GPIO_Init->Mode & 0x00200000U) EXTI->FTSR |= bit; else EXTI->FTSR &= ~bit;
+        }
+    }
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin)
+{
+    RECORD(GPIOx, GPIO_Pin, 0);
+    for (uint32_t line = 0; line < 16; line++) {
+        uint32_t bit = 1UL << line;
+        if ((GPIO_Pin & bit) == 0) continue;
+        GPIOx->MODER &= ~(3UL << (line * 2));
+        if (exti_port[line] == GPIOx) {
+            exti_port[line] = NULL;
+            EXTI->IMR &= ~bit;
+        }
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    RECORD(GPIOx, GPIO_Pin, PinState);
+    if (PinState != GPIO_PIN_RESET) {
+        GPIOx->ODR |= GPIO_Pin;
+        GPIOx->IDR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+        GPIOx->IDR &= ~(uint32_t)GPIO_Pin;
+    }
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    RECORD(GPIOx, GPIO_Pin, 0);
+    GPIOx->ODR ^= GPIO_Pin;
+    GPIOx->IDR = (GPIOx->IDR & ~(uint32_t)GPIO_Pin) | (GPIOx->ODR & GPIO_Pin);
+}
+
+void HalMock_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    bool was = (port->IDR & pin) != 0;
+    bool now = (state != GPIO_PIN_RESET);
+    if (now) port->IDR |= pin; else port->IDR &= ~(uint32_t)pin;
+    if (was == now) return;
+
+    uint32_t line = (uint32_t)__builtin_ctz(pin);
+    if (exti_port[line] != port || (EXTI->IMR & pin) == 0) return;
+    if ((now && (EXTI->RTSR & pin)) || (!now && (EXTI->FTSR & pin))) {
+        EXTI->PR |= pin;
+        HalMock_RaiseIrq(HalMock_ExtiIrq(line));
+    }
+}
+
+// ============================================================================
+// TIM
+// ============================================================================
+
+__attribute__((weak)) void HAL_TIM_PWM_MspInit(TIM_HandleTypeDef *htim)
+{
+    (void)htim;
+}
+
+static void HalMock_TimerConfig(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->PSC = htim->Init.Prescaler;
+    htim->Instance->ARR = htim->Init.Period;
+    htim->Instance->CR1 = (htim->Instance->CR1 & ~0x80UL) | htim->Init.AutoReloadPreload;
+    htim->Instance->CNT = 0;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+    RECORD(htim->Instance, htim->Init.Prescaler, htim->Init.Period);
+    if (htim->Instance == NULL) return HAL_ERROR;
+    HalMock_TimerConfig(htim);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim)
+{
+    RECORD(htim->Instance, 0, 0);
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    RECORD(htim->Instance, 0, 0);
+    htim->Instance->DIER |= TIM_DIER_UIE;
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    RECORD(htim->Instance, 0, 0);
+    htim->Instance->DIER &= ~TIM_DIER_UIE;
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim)
+{
+    RECORD(htim->Instance, htim->Init.Prescaler, htim->Init.Period);
+    if (htim->Instance == NULL) return HAL_ERROR;
+    HAL_TIM_PWM_MspInit(htim);
+    HalMock_TimerConfig(htim);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig,
+                                            uint32_t Channel)
+{
+    RECORD(htim->Instance, Channel, sConfig->Pulse);
+    if (Channel > TIM_CHANNEL_4) return HAL_ERROR;
+    __HAL_TIM_SET_COMPARE(htim, Channel, sConfig->Pulse);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    RECORD(htim->Instance, Channel, 0);
+    htim->Instance->CCER |= 1UL << Channel;     // CCxE is bit 4 * (channel index)
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+// ============================================================================
+// UART
+// ============================================================================
+
+static int HalMock_UartIndex(const USART_TypeDef *usart)
+{
+    for (int i = 0; i < 7; i++) {
+        if (usart == &halmock_usart[i]) return i;
+    }
+    return -1;
+}
+
+__attribute__((weak)) void HAL_UART_MspInit(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+__attribute__((weak)) void HAL_UART_MspDeInit(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+__attribute__((weak)) void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    RECORD(huart->Instance, huart->Init.BaudRate, 0);
+    int i = HalMock_UartIndex(huart->Instance);
+    if (i < 0 || huart->Init.BaudRate == 0) return HAL_ERROR;
+
+    HAL_UART_MspInit(huart);
+    uart_handle[i] = huart;
+    huart->RxXferCount = 0;
+    huart->Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK2Freq(), huart->Init.BaudRate);
+    huart->Instance->SR = USART_SR_TC | USART_SR_TXE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart)
+{
+    RECORD(huart->Instance, 0, 0);
+    int i = HalMock_UartIndex(huart->Instance);
+    if (i < 0) return HAL_ERROR;
+    HAL_UART_MspDeInit(huart);
+    uart_handle[i] = NULL;
+    return HAL_OK;
+}
+
+static void HalMock_UartSend(const USART_TypeDef *usart, const uint8_t *data, uint16_t size)
+{
+    if (tx_hook != NULL) {
+        tx_hook(usart, data, size);
+    } else {
+        fwrite(data, 1, size, stdout);
+        fflush(stdout);
+    }
+}
+
+/* Character time, start + 8 data + stop bits, rounded up to 1 us */
+static uint32_t HalMock_UartByteUs(const USART_TypeDef *usart)
+{
+    uint32_t baud = uart_baud;
+    if (baud == 0) {
+        uint32_t brr = usart->BRR ? usart->BRR : 1U;
+        baud = HAL_RCC_GetPCLK2Freq() / brr;
+    }
+    if (baud == 0) baud = 1U;
+    return (10U * 1000000U + baud - 1U) / baud;
+}
+
+uint32_t HalMock_UartByteTimeUs(const USART_TypeDef *usart)
+{
+    return HalMock_UartByteUs(usart);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size,
+                                    uint32_t Timeout)
+{
+    RECORD(huart->Instance, Size, Timeout);
+    if (pData == NULL || Size == 0) return HAL_ERROR;
+
+    if (!uart_timing) {
+        HalMock_UartSend(huart->Instance, pData, Size);
+        return HAL_OK;
+    }
+
+    /* Polling transmit as in the HAL: one timeout from the start for the whole
+     * block, interrupts still served while waiting for TXE */
+    uint32_t tickstart = HAL_GetTick();
+    uint32_t byte_us = HalMock_UartByteUs(huart->Instance);
+    for (uint16_t i = 0; i < Size; i++) {
+        huart->Instance->SR &= ~(USART_SR_TC | USART_SR_TXE);
+        for (uint32_t t = 0; t < byte_us; t++) {
+            if (Timeout != HAL_MAX_DELAY && HAL_GetTick() - tickstart > Timeout) {
+                huart->Instance->SR |= USART_SR_TC | USART_SR_TXE;
+                uart_tx_timeouts[HalMock_UartIndex(huart->Instance)]++;
+                return HAL_TIMEOUT;
+            }
+            HalMock_Step();
+        }
+        huart->Instance->SR |= USART_SR_TC | USART_SR_TXE;
+        HalMock_UartSend(huart->Instance, &pData[i], 1);
+    }
+    return HAL_OK;
+}
+
+void HalMock_SetUartTiming(bool enabled, uint32_t baud)
+{
+    uart_timing = enabled;
+    uart_baud = baud;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    RECORD(huart->Instance, Size, 0);
+    if (pData == NULL || Size == 0) return HAL_ERROR;
+    if (huart->RxXferCount != 0) return HAL_BUSY;
+
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    huart->RxXferCount = Size;
+    return HAL_OK;
+}
+
+void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
+{
+    if (huart == NULL || (huart->Instance->SR & USART_SR_RXNE) == 0) return;
+    huart->Instance->SR &= ~USART_SR_RXNE;
+
+    if (huart->RxXferCount == 0) {
+        uart_overruns[HalMock_UartIndex(huart->Instance)]++;
+        return;
+    }
+
+    *huart->pRxBuffPtr++ = (uint8_t)huart->Instance->DR;
+    if (--huart->RxXferCount == 0) {
+        HAL_UART_RxCpltCallback(huart);
+    }
+}
+
+bool HalMock_UartReceive(USART_TypeDef *usart, uint8_t byte)
+{
+    int i = HalMock_UartIndex(usart);
+    if (i < 0) return false;
+
+    bool armed = (uart_handle[i] != NULL && uart_handle[i]->RxXferCount != 0);
+    usart->DR = byte;
+    usart->SR |= USART_SR_RXNE;
+    if (i == 1) {
+        HalMock_RaiseIrq(USART1_IRQn);
+    } else if (uart_handle[i] != NULL) {
+        HAL_UART_IRQHandler(uart_handle[i]);
+    }
+    return armed;
+}
+
+uint32_t HalMock_UartOverruns(USART_TypeDef *usart)
+{
+    int i = HalMock_UartIndex(usart);
+    return (i < 0) ? 0 : uart_overruns[i];
+}
+
+uint32_t HalMock_UartTxTimeouts(USART_TypeDef *usart)
+{
+    int i = HalMock_UartIndex(usart);
+    return (i < 0) ? 0 : uart_tx_timeouts[i];
+}
+
+void HalMock_SetTxHook(HalMock_TxHook hook)
+{
+    tx_hook = hook;
+}
+
+// ============================================================================
+// Reset and call log
+// ============================================================================
+
+void HalMock_ClearCalls(void)
+{
+    call_total = 0;
+    call_count_n = 0;
+}
+
+uint32_t HalMock_CallCount(const char *fn)
+{
+    for (uint8_t i = 0; i < call_count_n; i++) {
+        if (strcmp(call_counts[i].fn, fn) == 0) return call_counts[i].count;
+    }
+    return 0;
+}
+
+uint32_t HalMock_CallLogLength(void)
+{
+    return (call_total < HALMOCK_CALL_LOG_SIZE) ? call_total : HALMOCK_CALL_LOG_SIZE;
+}
+
+bool HalMock_GetCall(uint32_t index, HalMock_Call *call)
+{
+    uint32_t len = HalMock_CallLogLength();
+    if (index >= len) return false;
+    *call = call_log[(call_total - len + index) % HALMOCK_CALL_LOG_SIZE];
+    return true;
+}
+
+void HalMock_Reset(void)
+{
+    memset(halmock_gpio, 0, sizeof(halmock_gpio));
+    memset(halmock_tim, 0, sizeof(halmock_tim));
+    memset(halmock_usart, 0, sizeof(halmock_usart));
+    memset(&halmock_exti, 0, sizeof(halmock_exti));
+    memset(&halmock_rcc, 0, sizeof(halmock_rcc));
+    memset(&halmock_dwt, 0, sizeof(halmock_dwt));
+    memset(&halmock_coredebug, 0, sizeof(halmock_coredebug));
+    memset(&halmock_scb, 0, sizeof(halmock_scb));
+    memset(&halmock_systick, 0, sizeof(halmock_systick));
+
+    SystemCoreClock = HSI_VALUE;
+    sysclk_hz = HSI_VALUE;
+    sysclk_source = RCC_SYSCLKSOURCE_HSI;
+    pll_out_hz = 0;
+    halmock_flash_latency = FLASH_LATENCY_0;
+    halmock_voltage_scale = PWR_REGULATOR_VOLTAGE_SCALE1;
+
+    now_us = 0;
+    tick_ms = 0;
+    primask = 0;
+    active_irq = -1;
+    irq_enabled = 0;
+    irq_pending = 0;
+    memset(irq_priority, 0, sizeof(irq_priority));
+    memset(tim_prescale, 0, sizeof(tim_prescale));
+    cycles_frac = 0;
+    memset(exti_port, 0, sizeof(exti_port));
+    memset(uart_handle, 0, sizeof(uart_handle));
+    memset(uart_overruns, 0, sizeof(uart_overruns));
+    memset(uart_tx_timeouts, 0, sizeof(uart_tx_timeouts));
+    tx_hook = NULL;
+    step_hook_count = 0;
+    uart_timing = false;
+    uart_baud = 0;
+
+    HalMock_ClearCalls();
+}
+
+/**
+ * @brief Firmware fault: report the virtual time and exit (runner and tests)
+ */
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler at %llu us\n", (unsigned long long)now_us);
+    exit(1);
+}
@@ -0,0 +1,378 @@
+/**
+ * @file    host_main.c
+ * @brief   Host runner: firmware modules on the HAL mock, commands from stdin
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Brings the modules up with the same App_Init / App_StartTasks as main.c
+ * (app_tasks.c) and runs the same scheduler and tasks in virtual time,
+ * with the motors and encoders simulated by motor_sim.c. Telemetry goes to
+ * stdout.
+ *
+ * Input, one item per line:
+ *   C:...          sent to USART1 RX byte by byte, then HOST_COMMAND_GAP_MS run
+ *   wait <ms>      run the firmware for <ms> of virtual time
+ *   load <m> <Nm>  external load torque on simulated motor m
+ *   sim            print the simulated motor states
+ *   # ...          comment
+ * At end of input HOST_TAIL_MS are run so the last replies are flushed.
+ *
+ * Options:
+ *   --pty [PATH]   serve USART1 on a pseudo-terminal instead of stdin/stdout
+ *                  (symlinked to PATH if given) until SIGINT/SIGTERM
+ *   --baud N       simulated line rate for RX and TX (default: as programmed)
+ *   --no-realtime  with --pty: run virtual time as fast as possible
+ *   --bench FILE   run the benchmark suite, write the results as JSON to
+ *                  FILE ("-" = stdout) and exit (build with USE_BENCH)
+ *   --record FILE  write received commands and sent telemetry with their
+ *                  virtual time to a session file (build with USE_RECORDER)
+ *   --replay FILE  instead of stdin, send the commands of a session file at
+ *                  their recorded times (relative to its first record)
+ * With --pty or --baud the link statistics are printed to stderr at exit.
+ */
+
+#include "main.h"
+#include "hal_mock.h"
+#include "motor_sim.h"
+#include "uart_pty.h"
+#include "session_file.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_tasks.h"
+#include "scheduler.h"
+#include "clock_profile.h"
+#include "profiler.h"
+#include "timebase.h"
+#include "remote_command.h"
+#include "bench.h"
+#include "recorder.h"
+
+#define HOST_COMMAND_GAP_MS     20      // Virtual time after each command line
+#define HOST_TAIL_MS            100     // Virtual time after the last line
+#define HOST_PTY_SLICE_MS       10      // Virtual time between stop request checks
+
+static volatile sig_atomic_t host_stop;
+static FILE *record_file;               // --record
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+/**
+ * @brief Bring the firmware up like main() does, up to Scheduler_Start
+ */
+static void Host_Init(void)
+{
+    HalMock_Reset();
+
+    HAL_Init();
+    ClockProfile_Init(CLOCK_PROFILE_DEFAULT);
+    Timebase_Init();
+
+    App_Init();
+    MotorSim_Init();                    // Encoder pins are configured by now
+    App_StartTasks();
+}
+
+/**
+ * @brief Move recorded lines from the ring to the session file
+ */
+static void Host_RecordDrain(void)
+{
+    #ifdef USE_RECORDER
+    if (record_file == NULL) return;
+
+    uint8_t records[RECORDER_MAX_RECORD * 4];
+    uint16_t n;
+    while ((n = Recorder_Read(records, sizeof(records))) > 0) {
+        SessionFile_Write(record_file, records, n);
+    }
+    #endif
+}
+
+/**
+ * @brief Run the main loop until a virtual time, us
+ */
+static void Host_RunUntil(uint64_t end_us)
+{
+    while (HalMock_NowUs() < end_us) {
+        if (Scheduler_Dispatch() == 0)
+            Scheduler_Idle();
+        Host_RecordDrain();
+    }
+}
+
+/**
+ * @brief Run the main loop for ms of virtual time
+ */
+static void Host_Run(uint32_t ms)
+{
+    Host_RunUntil(HalMock_NowUs() + (uint64_t)ms * 1000U);
+}
+
+/**
+ * @brief Send one command line to USART1 RX
+ * Without UART timing the whole line lands at once, as a paste would.
+ */
+static void Host_SendLine(const char *line, uint32_t baud)
+{
+    for (const char *p = line; *p != '\0'; p++) {
+        HalMock_UartReceive(USART1, (uint8_t)*p);
+        if (baud != 0) HalMock_AdvanceUs(HalMock_UartByteTimeUs(USART1));
+    }
+    HalMock_UartReceive(USART1, '\n');
+}
+
+/**
+ * @brief Simulated plant state, one JSON line per motor
+ */
+static void Host_PrintSim(void)
+{
+    for (uint8_t m = 0; m < MOTOR_COUNT; m++) {
+        MotorSim_State st;
+        MotorSim_GetState((Motor_ID)m, &st);
+        printf("{\"sim\":%u,\"t_ms\":%llu,\"v\":%.2f,\"i\":%.3f,\"rpm\":%.1f,\"rev\":%.3f,\"edges\":%lu}\n",
+               m, (unsigned long long)(HalMock_NowUs() / 1000U), st.voltage_v, st.current_a,
+               st.speed_rpm, st.revolutions, (unsigned long)st.edges);
+    }
+}
+
+static void Host_OnSignal(int sig)
+{
+    (void)sig;
+    host_stop = 1;
+}
+
+/**
+ * @brief Link and command statistics, one JSON line on stderr
+ */
+static void Host_PrintLinkStats(bool pty)
+{
+    RemoteCommand_Stats cmd;
+    RemoteCommand_GetStats(&cmd);
+
+    fprintf(stderr, "{\"link\":{\"t_ms\":%llu,\"byte_us\":%lu,\"lines\":%lu,\"dropped\":%lu,"
+            "\"overruns\":%lu,\"tx_timeouts\":%lu",
+            (unsigned long long)(HalMock_NowUs() / 1000U),
+            (unsigned long)HalMock_UartByteTimeUs(USART1),
+            (unsigned long)cmd.lines, (unsigned long)cmd.dropped,
+            (unsigned long)HalMock_UartOverruns(USART1),
+            (unsigned long)HalMock_UartTxTimeouts(USART1));
+    if (pty) {
+        UartPty_Stats st;
+        UartPty_GetStats(&st);
+        fprintf(stderr, ",\"rx_bytes\":%lu,\"tx_bytes\":%lu,\"tx_lost\":%lu,\"replies\":%lu,"
+                "\"latency_us\":{\"min\":%lu,\"avg\":%lu,\"max\":%lu}",
+                (unsigned long)st.rx_bytes, (unsigned long)st.tx_bytes,
+                (unsigned long)st.tx_lost, (unsigned long)st.latency_count,
+                (unsigned long)st.latency_min_us,
+                (unsigned long)(st.latency_count ? st.latency_total_us / st.latency_count : 0),
+                (unsigned long)st.latency_max_us);
+    }
+    fprintf(stderr, "}}\n");
+}
+
+/**
+ * @brief Serve USART1 on a pty until SIGINT/SIGTERM
+ */
+static int Host_ServePty(const char *link_path, uint32_t baud, bool realtime)
+{
+    if (!UartPty_Open(USART1, link_path, baud, realtime)) return 1;
+
+    fprintf(stderr, "USART1 on %s%s%s (%lu us/byte)\n", UartPty_Path(),
+            link_path ? " -> " : "", link_path ? link_path : "",
+            (unsigned long)HalMock_UartByteTimeUs(USART1));
+
+    signal(SIGINT, Host_OnSignal);
+    signal(SIGTERM, Host_OnSignal);
+    while (!host_stop) {
+        Host_Run(HOST_PTY_SLICE_MS);
+    }
+
+    Host_PrintLinkStats(true);
+    UartPty_Close();
+    return 0;
+}
+
+/**
+ * @brief Send the commands of a session file at their recorded times
+ * The run continues to the time of the last record plus HOST_TAIL_MS, so
+ * the telemetry of both sessions covers the same span.
+ */
+static int Host_Replay(const char *path, uint32_t baud)
+{
+    FILE *in = SessionFile_Open(path);
+    if (in == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    SessionFile_Record rec;
+    uint64_t start = HalMock_NowUs();
+    uint32_t first = 0, offset = 0, commands = 0;
+    bool have_first = false;
+
+    while (SessionFile_Next(in, &rec)) {
+        if (!have_first) {
+            first = rec.time_us;
+            have_first = true;
+        }
+        offset = rec.time_us - first;       // Timebase wraps after 71 min
+        if (rec.dir != RECORDER_IN) continue;
+
+        /* The record is stamped at '\n': with UART timing start that much earlier */
+        uint64_t at = start + offset;
+        uint64_t wire = (baud != 0) ? (uint64_t)(rec.len + 1U) * HalMock_UartByteTimeUs(USART1) : 0;
+        Host_RunUntil((at - start > wire) ? at - wire : start);
+        Host_SendLine(rec.line, baud);
+        commands++;
+    }
+    fclose(in);
+
+    Host_RunUntil(start + offset + HOST_TAIL_MS * 1000U);
+    fprintf(stderr, "replayed %lu commands over %lu ms\n", (unsigned long)commands,
+            (unsigned long)(offset / 1000U));
+    return 0;
+}
+
+/**
+ * @brief Run the benchmark suite and write the results file
+ * Same numbers as C:W on the target; cycles are ns here (cyc_us = 1000).
+ */
+static int Host_Bench(const char *path)
+{
+    #ifdef USE_BENCH
+    FILE *out = (strcmp(path, "-") == 0) ? stdout : fopen(path, "w");
+    if (out == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    Host_Run(HOST_TAIL_MS);
+
+    fprintf(out, "{\"target\":\"host\",\"cyc_us\":%lu,\"batch\":%u,\"results\":{",
+            (unsigned long)Profiler_CyclesPerUs(), BENCH_BATCH);
+    Bench_Result r;
+    for (uint8_t i = 0; Bench_Run(i, &r); i++) {
+        fprintf(out, "%s\n \"%s\":{\"n\":%lu,\"min\":%lu,\"avg\":%lu,\"max\":%lu}",
+                (i > 0) ? "," : "", r.name, (unsigned long)r.iterations,
+                (unsigned long)r.min, (unsigned long)r.avg, (unsigned long)r.max);
+        fprintf(stderr, "%-24s %8lu %8lu %8lu ns\n", r.name, (unsigned long)r.min,
+                (unsigned long)r.avg, (unsigned long)r.max);
+    }
+    fprintf(out, "\n}}\n");
+
+    if (out != stdout) fclose(out);
+    return 0;
+    #else
+    (void)path;
+    fprintf(stderr, "built without USE_BENCH (pio run -e native_bench)\n");
+    return 1;
+    #endif
+}
+
+/**
+ * @brief Commands and runner directives from stdin (see file header)
+ */
+static void Host_ReadCommands(uint32_t baud)
+{
+    char line[256];
+
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+
+        if (strncmp(line, "wait ", 5) == 0) {
+            Host_Run((uint32_t)strtoul(line + 5, NULL, 10));
+            continue;
+        }
+        if (strncmp(line, "load ", 5) == 0) {
+            char *end;
+            unsigned long motor = strtoul(line + 5, &end, 10);
+            MotorSim_SetLoad((Motor_ID)motor, strtof(end, NULL));
+            continue;
+        }
+        if (strcmp(line, "sim") == 0) {
+            Host_PrintSim();
+            continue;
+        }
+
+        Host_SendLine(line, baud);
+        Host_Run(HOST_COMMAND_GAP_MS);
+    }
+
+    Host_Run(HOST_TAIL_MS);
+}
+
+int main(int argc, char **argv)
+{
+    bool pty = false;
+    const char *link_path = NULL;
+    uint32_t baud = 0;
+    bool realtime = true;
+    const char *bench_path = NULL;
+    const char *record_path = NULL;
+    const char *replay_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--pty") == 0) {
+            pty = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') link_path = argv[++i];
+        } else if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc) {
+            baud = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--no-realtime") == 0) {
+            realtime = false;
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            bench_path = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--pty [PATH]] [--baud N] [--no-realtime] [--bench FILE]"
+                    " [--record FILE] [--replay FILE] [< commands]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (record_path != NULL) {
+        #ifdef USE_RECORDER
+        record_file = SessionFile_Create(record_path);
+        if (record_file == NULL) {
+            perror(record_path);
+            return 1;
+        }
+        #else
+        fprintf(stderr, "built without USE_RECORDER, --record ignored\n");
+        #endif
+    }
+
+    Host_Init();
+
+    int rc = 0;
+    if (bench_path != NULL) {
+        rc = Host_Bench(bench_path);
+    } else if (pty) {
+        rc = Host_ServePty(link_path, baud, realtime);
+    } else if (replay_path != NULL) {
+        if (baud != 0) HalMock_SetUartTiming(true, baud);
+        rc = Host_Replay(replay_path, baud);
+    } else {
+        if (baud != 0) HalMock_SetUartTiming(true, baud);
+        Host_ReadCommands(baud);
+        if (baud != 0) Host_PrintLinkStats(false);
+    }
+
+    if (record_file != NULL) {
+        Host_RecordDrain();
+        fclose(record_file);
+        #ifdef USE_RECORDER
+        if (Recorder_GetLost() > 0)
+            fprintf(stderr, "recorder: %lu records lost\n", (unsigned long)Recorder_GetLost());
+        #endif
+    }
+    return rc;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file    hal_mock.h
+ * @brief   Control interface of the host HAL mock (virtual time, inputs, UART)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Time only moves when the host asks for it: HalMock_AdvanceUs (or the
+ * firmware's own WFI / HAL_Delay) steps the virtual clock 1 us at a time,
+ * counts the enabled timers from their prescalers, raises SysTick every
+ * millisecond and delivers interrupts whose handlers the firmware defines
+ * (TIM5_IRQHandler, TIM1_BRK_TIM9_IRQHandler, EXTI*_IRQHandler...).
+ * Handlers are deferred while PRIMASK is set, as on the core. Code between
+ * two steps takes no virtual time, except a PLL start, which steps
+ * HALMOCK_PLL_LOCK_US with the clocks as configured at that moment.
+ *
+ * Every HAL call is appended to a call log (function name, first three
+ * arguments, virtual time) so tests can check what a module did.
+ */
+
+#ifndef HAL_MOCK_H
+#define HAL_MOCK_H
+
+#include "stm32f4xx_hal.h"
+
+#define HALMOCK_CALL_LOG_SIZE   256     // Most recent calls kept
+#define HALMOCK_STEP_HOOKS      4       // Per-microsecond hooks (plant, UART bridge...)
+#define HALMOCK_PLL_LOCK_US     200     // PLL lock time (STM32F411 datasheet: max 200 us)
+
+/** One recorded HAL call */
+typedef struct {
+    const char *fn;         // HAL function name
+    uint32_t a0, a1, a2;    // First arguments (pointers truncated)
+    uint64_t time_us;       // Virtual time of the call
+} HalMock_Call;
+
+/** Called once per simulated microsecond, before timers and SysTick */
+typedef void (*HalMock_StepHook)(uint64_t now_us);
+
+/** Receives the bytes sent with HAL_UART_Transmit (one at a time with UART timing) */
+typedef void (*HalMock_TxHook)(const USART_TypeDef *usart, const uint8_t *data, uint16_t size);
+
+/**
+ * @brief Clear all peripherals, interrupts, hooks and the call log; time = 0
+ */
+void HalMock_Reset(void);
+
+/**
+ * @brief Virtual time since the last reset, us
+ */
+uint64_t HalMock_NowUs(void);
+
+/**
+ * @brief Advance virtual time, delivering interrupts as they become due
+ * @param us Microseconds to simulate
+ */
+void HalMock_AdvanceUs(uint64_t us);
+
+/**
+ * @brief Run until an interrupt is pending (what WFI does), at most max_us
+ * @return Microseconds simulated
+ */
+uint32_t HalMock_AdvanceToInterrupt(uint32_t max_us);
+
+/**
+ * @brief Set the level of an input pin, raising EXTI on a configured edge
+ * @param port GPIO port (GPIOA...)
+ * @param pin Pin mask (GPIO_PIN_x, one pin)
+ * @param state New level
+ */
+void HalMock_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+
+/**
+ * @brief Deliver one received byte on a USART (RXNE interrupt)
+ * @return false if no reception was armed (byte lost, counted as overrun)
+ */
+bool HalMock_UartReceive(USART_TypeDef *usart, uint8_t byte);
+
+/**
+ * @brief Bytes received while no reception was armed
+ */
+uint32_t HalMock_UartOverruns(USART_TypeDef *usart);
+
+/**
+ * @brief HAL_UART_Transmit calls that hit their timeout (UART timing only)
+ */
+uint32_t HalMock_UartTxTimeouts(USART_TypeDef *usart);
+
+/**
+ * @brief Install the transmit hook (NULL = write to stdout)
+ */
+void HalMock_SetTxHook(HalMock_TxHook hook);
+
+/**
+ * @brief Add a per-microsecond hook, called in the order added
+ * @return false if all HALMOCK_STEP_HOOKS slots are taken
+ */
+bool HalMock_AddStepHook(HalMock_StepHook hook);
+
+/**
+ * @brief Make HAL_UART_Transmit take wire time
+ * When enabled every byte takes 10 bit times, virtual time (and interrupts)
+ * advance meanwhile, the HAL timeout is honoured (HAL_TIMEOUT, rest of the
+ * block not sent) and the transmit hook gets each byte when its stop bit
+ * ends. Off by default: transmit is instant.
+ * @param enabled Simulate wire time
+ * @param baud Line rate, 0 = the rate programmed in BRR
+ */
+void HalMock_SetUartTiming(bool enabled, uint32_t baud);
+
+/**
+ * @brief Time of one character on the line (10 bits), us
+ */
+uint32_t HalMock_UartByteTimeUs(const USART_TypeDef *usart);
+
+/**
+ * @brief Raise an interrupt (runs now if enabled and unmasked)
+ */
+void HalMock_RaiseIrq(IRQn_Type irq);
+
+/**
+ * @brief Number of recorded calls of a HAL function since reset
+ */
+uint32_t HalMock_CallCount(const char *fn);
+
+/**
+ * @brief Recorded call, 0 = oldest still in the log
+ * @return false if index is past the end of the log
+ */
+bool HalMock_GetCall(uint32_t index, HalMock_Call *call);
+
+/**
+ * @brief Number of calls currently in the log (<= HALMOCK_CALL_LOG_SIZE)
+ */
+uint32_t HalMock_CallLogLength(void);
+
+/**
+ * @brief Clear the call log and counters only
+ */
+void HalMock_ClearCalls(void);
+
+#endif // HAL_MOCK_H
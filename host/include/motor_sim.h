@@ -0,0 +1,89 @@
+/**
+ * @file    motor_sim.h
+ * @brief   Simulated DC motors and encoders for the host build
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Closes the loop around the firmware on the HAL mock. Every simulated
+ * microsecond each motor reads what the TB6612FNG driver left in the
+ * registers (PWM compare / auto-reload, IN1/IN2, STBY), integrates a
+ * first-order electrical and mechanical model at the wheel shaft, and
+ * drives its encoder pin so EXTI9_5_IRQHandler sees the slot edges at
+ * the moment the disk passes them (1 us resolution).
+ *
+ * Model (SI units, quantities at the gearbox output):
+ *   L di/dt = V - R i - Ke w          (open circuit when coasting: i = 0)
+ *   J dw/dt = Kt i - b w - Tc sgn(w) - T_load
+ * A stopped wheel stays put while |Kt i - T_load| <= Ts (static friction),
+ * which gives the PWM deadband. V is the PWM average: duty x supply for
+ * drive, 0 for short brake (PWM low is also a short brake on the TB6612FNG).
+ */
+
+#ifndef MOTOR_SIM_H
+#define MOTOR_SIM_H
+
+#include "hal_mock.h"
+#include "drivers/motor/tb6612fng.h"
+
+/** Motor parameters; defaults describe a 6 V TT gear motor with 65 mm wheel */
+typedef struct {
+    float supply_v;             // Driver VM, V
+    float resistance_ohm;       // Winding resistance
+    float inductance_h;         // Winding inductance
+    float ke;                   // Back-EMF constant, V/(rad/s)
+    float kt;                   // Torque constant, Nm/A
+    float inertia;              // Rotor (reflected) + wheel, kg m^2
+    float viscous;              // Viscous friction, Nm/(rad/s)
+    float coulomb_nm;           // Kinetic friction torque
+    float static_nm;            // Breakaway torque (>= coulomb_nm)
+    float load_nm;              // External load torque (positive opposes forward)
+} MotorSim_Params;
+
+/** Snapshot of one motor */
+typedef struct {
+    float voltage_v;            // Applied average voltage
+    float current_a;
+    float speed_rpm;            // Wheel speed, signed (forward > 0)
+    double revolutions;         // Wheel angle since reset, signed
+    uint32_t edges;             // Rising encoder edges generated
+} MotorSim_State;
+
+/**
+ * @brief Reset all motors to rest with default parameters and attach the
+ *        simulator to the HAL mock (HalMock_AddStepHook)
+ * Call after Encoder_Init so the encoder pins are configured.
+ */
+void MotorSim_Init(void);
+
+/**
+ * @brief Default parameters
+ */
+void MotorSim_DefaultParams(MotorSim_Params *params);
+
+/**
+ * @brief Replace the parameters of one motor (state is kept)
+ */
+void MotorSim_SetParams(Motor_ID motor, const MotorSim_Params *params);
+
+/**
+ * @brief Current parameters of one motor
+ */
+void MotorSim_GetParams(Motor_ID motor, MotorSim_Params *params);
+
+/**
+ * @brief Set the external load torque of one motor, Nm
+ */
+void MotorSim_SetLoad(Motor_ID motor, float load_nm);
+
+/**
+ * @brief Current state of one motor
+ */
+void MotorSim_GetState(Motor_ID motor, MotorSim_State *state);
+
+/**
+ * @brief Advance all motors by 1 us (the HalMock step hook)
+ * Exposed so a test can chain its own step hook in front of it.
+ */
+void MotorSim_Step(uint64_t now_us);
+
+#endif // MOTOR_SIM_H
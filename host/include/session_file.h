@@ -0,0 +1,55 @@
+/**
+ * @file    session_file.h
+ * @brief   Session files: recorded commands and telemetry (recorder.h records)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * A session file is an 8-byte header ("BPRC", version, 3 reserved bytes)
+ * followed by records in the recorder ring layout (recorder.h). The same
+ * files come from the host build (--record), from a firmware dump (C:G,
+ * converted by tools/session.py extract) and from tools/session.py record.
+ */
+
+#ifndef SESSION_FILE_H
+#define SESSION_FILE_H
+
+#include "recorder.h"
+#include <stdio.h>
+#include <stddef.h>
+
+#define SESSION_FILE_MAGIC      "BPRC"
+#define SESSION_FILE_VERSION    1
+#define SESSION_FILE_HEADER     8
+
+/** One decoded record */
+typedef struct {
+    uint32_t time_us;
+    Recorder_Dir dir;
+    uint8_t len;
+    char line[RECORDER_MAX_LINE + 1];   // NUL-terminated
+} SessionFile_Record;
+
+/**
+ * @brief Create a session file and write the header
+ * @return NULL on error (errno set)
+ */
+FILE *SessionFile_Create(const char *path);
+
+/**
+ * @brief Append raw records (as returned by Recorder_Read)
+ */
+bool SessionFile_Write(FILE *file, const uint8_t *records, size_t size);
+
+/**
+ * @brief Open a session file and check the header
+ * @return NULL if missing or not a session file
+ */
+FILE *SessionFile_Open(const char *path);
+
+/**
+ * @brief Read the next record
+ * @return false at the end of the file (or a truncated record)
+ */
+bool SessionFile_Next(FILE *file, SessionFile_Record *record);
+
+#endif // SESSION_FILE_H
@@ -0,0 +1,452 @@
+/**
+ * @file    stm32f4xx_hal.h
+ * @brief   Host (native) replacement for the STM32F4 HAL and CMSIS core
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Only what the firmware modules use. Peripheral registers are plain
+ * structs in RAM (register macros and __HAL_* accessors work unchanged),
+ * HAL functions are implemented in host/hal_mock.c and recorded in a call
+ * log. Constants keep their real values where the code depends on them
+ * (EXTI edge bits of GPIO modes, APB divider encoding, channel offsets).
+ *
+ * Test and simulator control (virtual time, inputs, UART) is in hal_mock.h.
+ */
+
+#ifndef STM32F4XX_HAL_H
+#define STM32F4XX_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define __IO    volatile
+#define __I     volatile const
+
+// ============================================================================
+// Common types
+// ============================================================================
+
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum { RESET = 0U, SET = !RESET } FlagStatus, ITStatus;
+
+#define HAL_MAX_DELAY   0xFFFFFFFFU
+
+// ============================================================================
+// Peripheral registers
+// ============================================================================
+
+typedef struct {
+    __IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR,
+                  RCR, CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR, OR;
+} TIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t SR, DR, BRR, CR1, CR2, CR3, GTPR;
+} USART_TypeDef;
+
+typedef struct {
+    __IO uint32_t IMR, EMR, RTSR, FTSR, SWIER, PR;
+} EXTI_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR, PLLCFGR, CFGR, CIR;
+} RCC_TypeDef;
+
+typedef struct {
+    __IO uint32_t CTRL, CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+    __IO uint32_t CPUID, ICSR, VTOR, AIRCR, SCR, CCR;
+} SCB_Type;
+
+typedef struct {
+    __IO uint32_t CTRL, LOAD, VAL, CALIB;
+} SysTick_Type;
+
+extern GPIO_TypeDef     halmock_gpio[8];        // A..H
+extern TIM_TypeDef      halmock_tim[12];        // Index = timer number
+extern USART_TypeDef    halmock_usart[7];
+extern EXTI_TypeDef     halmock_exti;
+extern RCC_TypeDef      halmock_rcc;
+extern DWT_Type         halmock_dwt;
+extern CoreDebug_Type   halmock_coredebug;
+extern SCB_Type         halmock_scb;
+extern SysTick_Type     halmock_systick;
+
+#define GPIOA       (&halmock_gpio[0])
+#define GPIOB       (&halmock_gpio[1])
+#define GPIOC       (&halmock_gpio[2])
+#define GPIOD       (&halmock_gpio[3])
+#define GPIOE       (&halmock_gpio[4])
+#define GPIOH       (&halmock_gpio[7])
+
+#define TIM1        (&halmock_tim[1])
+#define TIM2        (&halmock_tim[2])
+#define TIM3        (&halmock_tim[3])
+#define TIM4        (&halmock_tim[4])
+#define TIM5        (&halmock_tim[5])
+#define TIM9        (&halmock_tim[9])
+#define TIM10       (&halmock_tim[10])
+#define TIM11       (&halmock_tim[11])
+
+#define USART1      (&halmock_usart[1])
+#define USART2      (&halmock_usart[2])
+#define USART6      (&halmock_usart[6])
+
+#define EXTI        (&halmock_exti)
+#define RCC         (&halmock_rcc)
+#define DWT         (&halmock_dwt)
+#define CoreDebug   (&halmock_coredebug)
+#define SCB         (&halmock_scb)
+#define SysTick     (&halmock_systick)
+
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define SCB_SCR_SLEEPONEXIT_Msk     (1UL << 1)
+#define SCB_SCR_SLEEPDEEP_Msk       (1UL << 2)
+#define SCB_ICSR_VECTACTIVE_Msk     (0x1FFUL)
+#define SCB_ICSR_PENDSTSET_Msk      (1UL << 26)
+
+#define RCC_CFGR_PPRE1              (0x7UL << 10)
+#define RCC_CFGR_PPRE2              (0x7UL << 13)
+
+#define TIM_CR1_CEN                 (1UL << 0)
+#define TIM_CR1_URS                 (1UL << 2)
+#define TIM_DIER_UIE                (1UL << 0)
+#define TIM_SR_UIF                  (1UL << 0)
+#define TIM_EGR_UG                  (1UL << 0)
+
+#define USART_SR_RXNE               (1UL << 5)
+#define USART_SR_TC                 (1UL << 6)
+#define USART_SR_TXE                (1UL << 7)
+
+// ============================================================================
+// Interrupts
+// ============================================================================
+
+typedef enum {
+    SysTick_IRQn                = -1,
+    EXTI0_IRQn                  = 6,
+    EXTI1_IRQn                  = 7,
+    EXTI2_IRQn                  = 8,
+    EXTI3_IRQn                  = 9,
+    EXTI4_IRQn                  = 10,
+    EXTI9_5_IRQn                = 23,
+    TIM1_BRK_TIM9_IRQn          = 24,
+    TIM1_UP_TIM10_IRQn          = 25,
+    TIM1_TRG_COM_TIM11_IRQn     = 26,
+    TIM2_IRQn                   = 28,
+    TIM3_IRQn                   = 29,
+    TIM4_IRQn                   = 30,
+    USART1_IRQn                 = 37,
+    EXTI15_10_IRQn              = 40,
+    TIM5_IRQn                   = 50
+} IRQn_Type;
+
+#define HALMOCK_IRQ_COUNT   64
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+// ============================================================================
+// CMSIS core intrinsics (PRIMASK is tracked, WFI advances virtual time)
+// ============================================================================
+
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+uint32_t __get_MSP(void);
+uint32_t __get_IPSR(void);
+void __WFI(void);
+static inline void __DSB(void) {}
+static inline void __ISB(void) {}
+static inline void __NOP(void) {}
+
+// ============================================================================
+// HAL core, RCC, PWR, FLASH
+// ============================================================================
+
+extern uint32_t SystemCoreClock;
+
+HAL_StatusTypeDef HAL_Init(void);
+uint32_t HAL_GetTick(void);
+void HAL_IncTick(void);
+void HAL_Delay(uint32_t Delay);
+
+typedef struct {
+    uint32_t PLLState, PLLSource, PLLM, PLLN, PLLP, PLLQ;
+} RCC_PLLInitTypeDef;
+
+typedef struct {
+    uint32_t OscillatorType, HSEState, LSEState, HSIState, HSICalibrationValue, LSIState;
+    RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct {
+    uint32_t ClockType, SYSCLKSource, AHBCLKDivider, APB1CLKDivider, APB2CLKDivider;
+} RCC_ClkInitTypeDef;
+
+#define RCC_OSCILLATORTYPE_NONE     0x00000000U
+#define RCC_OSCILLATORTYPE_HSE      0x00000001U
+#define RCC_OSCILLATORTYPE_HSI      0x00000002U
+#define RCC_HSE_OFF                 0x00000000U
+#define RCC_HSE_ON                  0x00010000U
+#define RCC_HSI_ON                  0x00000001U
+#define RCC_PLL_NONE                0x00000000U
+#define RCC_PLL_OFF                 0x00000001U
+#define RCC_PLL_ON                  0x00000002U
+#define RCC_PLLSOURCE_HSI           0x00000000U
+#define RCC_PLLSOURCE_HSE           0x00400000U
+#define RCC_PLLP_DIV2               0x00000002U
+#define RCC_PLLP_DIV4               0x00000004U
+#define RCC_PLLP_DIV6               0x00000006U
+#define RCC_PLLP_DIV8               0x00000008U
+
+#define RCC_CLOCKTYPE_SYSCLK        0x00000001U
+#define RCC_CLOCKTYPE_HCLK          0x00000002U
+#define RCC_CLOCKTYPE_PCLK1         0x00000004U
+#define RCC_CLOCKTYPE_PCLK2         0x00000008U
+#define RCC_SYSCLKSOURCE_HSI        0x00000000U
+#define RCC_SYSCLKSOURCE_HSE        0x00000001U
+#define RCC_SYSCLKSOURCE_PLLCLK     0x00000002U
+#define RCC_SYSCLK_DIV1             0x00000000U
+#define RCC_HCLK_DIV1               0x00000000U
+#define RCC_HCLK_DIV2               0x00001000U
+#define RCC_HCLK_DIV4               0x00001400U
+#define RCC_HCLK_DIV8               0x00001800U
+#define RCC_HCLK_DIV16              0x00001C00U
+
+#define FLASH_LATENCY_0             0U
+#define FLASH_LATENCY_1             1U
+#define FLASH_LATENCY_2             2U
+#define FLASH_LATENCY_3             3U
+
+#define PWR_REGULATOR_VOLTAGE_SCALE1    0x0000C000U
+#define PWR_REGULATOR_VOLTAGE_SCALE2    0x00008000U
+#define PWR_REGULATOR_VOLTAGE_SCALE3    0x00004000U
+
+#define HSE_VALUE                   25000000U
+#define HSI_VALUE                   16000000U
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+uint32_t HAL_RCC_GetSysClockFreq(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+extern uint32_t halmock_flash_latency;
+extern uint32_t halmock_voltage_scale;
+
+#define __HAL_FLASH_GET_LATENCY()               (halmock_flash_latency)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(scale)  (halmock_voltage_scale = (scale))
+
+#define __HAL_RCC_PWR_CLK_ENABLE()      ((void)0)
+#define __HAL_RCC_SYSCFG_CLK_ENABLE()   ((void)0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOH_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_TIM1_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_TIM2_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_TIM3_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_TIM4_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_TIM5_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_TIM9_CLK_ENABLE()     ((void)0)
+#define __HAL_RCC_TIM10_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_TIM11_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_USART1_CLK_ENABLE()   ((void)0)
+#define __HAL_RCC_USART1_CLK_DISABLE()  ((void)0)
+
+// ============================================================================
+// GPIO / EXTI
+// ============================================================================
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+typedef struct {
+    uint32_t Pin, Mode, Pull, Speed, Alternate;
+} GPIO_InitTypeDef;
+
+#define GPIO_PIN_0      ((uint16_t)0x0001)
+#define GPIO_PIN_1      ((uint16_t)0x0002)
+#define GPIO_PIN_2      ((uint16_t)0x0004)
+#define GPIO_PIN_3      ((uint16_t)0x0008)
+#define GPIO_PIN_4      ((uint16_t)0x0010)
+#define GPIO_PIN_5      ((uint16_t)0x0020)
+#define GPIO_PIN_6      ((uint16_t)0x0040)
+#define GPIO_PIN_7      ((uint16_t)0x0080)
+#define GPIO_PIN_8      ((uint16_t)0x0100)
+#define GPIO_PIN_9      ((uint16_t)0x0200)
+#define GPIO_PIN_10     ((uint16_t)0x0400)
+#define GPIO_PIN_11     ((uint16_t)0x0800)
+#define GPIO_PIN_12     ((uint16_t)0x1000)
+#define GPIO_PIN_13     ((uint16_t)0x2000)
+#define GPIO_PIN_14     ((uint16_t)0x4000)
+#define GPIO_PIN_15     ((uint16_t)0x8000)
+#define GPIO_PIN_All    ((uint16_t)0xFFFF)
+
+#define GPIO_MODE_INPUT                 0x00000000U
+#define GPIO_MODE_OUTPUT_PP             0x00000001U
+#define GPIO_MODE_OUTPUT_OD             0x00000011U
+#define GPIO_MODE_AF_PP                 0x00000002U
+#define GPIO_MODE_AF_OD                 0x00000012U
+#define GPIO_MODE_ANALOG                0x00000003U
+#define GPIO_MODE_IT_RISING             0x10110000U
+#define GPIO_MODE_IT_FALLING            0x10210000U
+#define GPIO_MODE_IT_RISING_FALLING     0x10310000U
+
+#define GPIO_NOPULL                     0x00000000U
+#define GPIO_PULLUP                     0x00000001U
+#define GPIO_PULLDOWN                   0x00000002U
+
+#define GPIO_SPEED_FREQ_LOW             0x00000000U
+#define GPIO_SPEED_FREQ_MEDIUM          0x00000001U
+#define GPIO_SPEED_FREQ_HIGH            0x00000002U
+#define GPIO_SPEED_FREQ_VERY_HIGH       0x00000003U
+
+#define GPIO_AF1_TIM1                   0x01U
+#define GPIO_AF1_TIM2                   0x01U
+#define GPIO_AF2_TIM3                   0x02U
+#define GPIO_AF2_TIM4                   0x02U
+#define GPIO_AF2_TIM5                   0x02U
+#define GPIO_AF3_TIM9                   0x03U
+#define GPIO_AF3_TIM10                  0x03U
+#define GPIO_AF3_TIM11                  0x03U
+#define GPIO_AF7_USART1                 0x07U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+#define __HAL_GPIO_EXTI_GET_IT(pin)     (EXTI->PR & (pin))
+#define __HAL_GPIO_EXTI_CLEAR_IT(pin)   (EXTI->PR &= ~(uint32_t)(pin))
+#define __HAL_GPIO_EXTI_GET_FLAG(pin)   __HAL_GPIO_EXTI_GET_IT(pin)
+#define __HAL_GPIO_EXTI_CLEAR_FLAG(pin) __HAL_GPIO_EXTI_CLEAR_IT(pin)
+
+// ============================================================================
+// TIM
+// ============================================================================
+
+typedef struct {
+    uint32_t Prescaler, CounterMode, Period, ClockDivision, RepetitionCounter,
+             AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+typedef struct {
+    uint32_t OCMode, Pulse, OCPolarity, OCNPolarity, OCFastMode, OCIdleState, OCNIdleState;
+} TIM_OC_InitTypeDef;
+
+typedef struct {
+    uint32_t ClockSource, ClockPolarity, ClockPrescaler, ClockFilter;
+} TIM_ClockConfigTypeDef;
+
+#define TIM_COUNTERMODE_UP              0x00000000U
+#define TIM_CLOCKDIVISION_DIV1          0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE  0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_ENABLE   0x00000080U
+#define TIM_CLOCKSOURCE_INTERNAL        0x00001000U
+#define TIM_OCMODE_PWM1                 0x00000060U
+#define TIM_OCPOLARITY_HIGH             0x00000000U
+#define TIM_OCFAST_DISABLE              0x00000000U
+#define TIM_CHANNEL_1                   0x00000000U
+#define TIM_CHANNEL_2                   0x00000004U
+#define TIM_CHANNEL_3                   0x00000008U
+#define TIM_CHANNEL_4                   0x0000000CU
+#define TIM_FLAG_UPDATE                 TIM_SR_UIF
+#define TIM_IT_UPDATE                   TIM_DIER_UIE
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig,
+                                            uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+void HAL_TIM_PWM_MspInit(TIM_HandleTypeDef *htim);
+
+#define __HAL_TIM_GET_AUTORELOAD(h)         ((h)->Instance->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(h, v)      ((h)->Instance->ARR = (v), (h)->Init.Period = (v))
+#define __HAL_TIM_SET_COMPARE(h, ch, v)     (*(&(h)->Instance->CCR1 + ((ch) >> 2U)) = (v))
+#define __HAL_TIM_GET_COMPARE(h, ch)        (*(&(h)->Instance->CCR1 + ((ch) >> 2U)))
+#define __HAL_TIM_SET_PRESCALER(h, v)       ((h)->Instance->PSC = (v))
+#define __HAL_TIM_GET_COUNTER(h)            ((h)->Instance->CNT)
+#define __HAL_TIM_SET_COUNTER(h, v)         ((h)->Instance->CNT = (v))
+#define __HAL_TIM_GET_FLAG(h, f)            (((h)->Instance->SR & (f)) == (f))
+#define __HAL_TIM_CLEAR_FLAG(h, f)          ((h)->Instance->SR = ~(uint32_t)(f))
+#define __HAL_TIM_CLEAR_IT(h, f)            ((h)->Instance->SR = ~(uint32_t)(f))
+
+// ============================================================================
+// UART
+// ============================================================================
+
+typedef struct {
+    uint32_t BaudRate, WordLength, StopBits, Parity, Mode, HwFlowCtl, OverSampling;
+} UART_InitTypeDef;
+
+typedef struct {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    uint8_t *pRxBuffPtr;
+    uint16_t RxXferSize;
+    uint16_t RxXferCount;
+} UART_HandleTypeDef;
+
+#define UART_WORDLENGTH_8B      0x00000000U
+#define UART_STOPBITS_1         0x00000000U
+#define UART_PARITY_NONE        0x00000000U
+#define UART_MODE_TX_RX         0x0000000CU
+#define UART_HWCONTROL_NONE     0x00000000U
+#define UART_OVERSAMPLING_16    0x00000000U
+#define UART_FLAG_RXNE          USART_SR_RXNE
+#define UART_FLAG_TC            USART_SR_TC
+#define UART_FLAG_TXE           USART_SR_TXE
+
+#define UART_BRR_SAMPLING16(pclk, baud) ((uint32_t)(((pclk) + (baud) / 2U) / (baud)))
+#define __HAL_UART_GET_FLAG(h, f)       (((h)->Instance->SR & (f)) == (f))
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size,
+                                    uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+void HAL_UART_IRQHandler(UART_HandleTypeDef *huart);
+void HAL_UART_MspInit(UART_HandleTypeDef *huart);
+void HAL_UART_MspDeInit(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STM32F4XX_HAL_H
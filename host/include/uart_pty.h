@@ -0,0 +1,60 @@
+/**
+ * @file    uart_pty.h
+ * @brief   USART of the host build exposed as a Linux pseudo-terminal
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * The slave side (/dev/pts/N, optionally symlinked to a fixed path) behaves
+ * like the serial port of the board: tools open it and exchange "C:..."
+ * commands and telemetry lines. Both directions are throttled to the line
+ * rate: received bytes are delivered to the USART one character time apart
+ * and HAL_UART_Transmit takes wire time (HalMock_SetUartTiming).
+ *
+ * With real-time pacing virtual time is held to the wall clock, so the
+ * firmware answers with the same delays as the board would.
+ */
+
+#ifndef UART_PTY_H
+#define UART_PTY_H
+
+#include "hal_mock.h"
+
+/** Link statistics since UartPty_Open */
+typedef struct {
+    uint32_t rx_bytes;          // Delivered to the USART
+    uint32_t rx_overruns;       // Arrived while no reception was armed
+    uint32_t tx_bytes;          // Written to the pty
+    uint32_t tx_lost;           // Dropped: pty buffer full (nobody reading)
+    uint32_t tx_timeouts;       // HAL_UART_Transmit timeouts (message cut short)
+    uint32_t latency_count;     // Command lines answered
+    uint32_t latency_min_us;    // End of command line -> first reply byte sent
+    uint32_t latency_max_us;
+    uint64_t latency_total_us;
+} UartPty_Stats;
+
+/**
+ * @brief Create the pty and attach it to a USART
+ * @param usart USART whose RX/TX go through the pty (USART1)
+ * @param link_path Symlink to create to the slave device, NULL = none
+ * @param baud Line rate, 0 = the rate programmed by the firmware
+ * @param realtime Pace virtual time to the wall clock
+ * @return false if the pty could not be created
+ */
+bool UartPty_Open(USART_TypeDef *usart, const char *link_path, uint32_t baud, bool realtime);
+
+/**
+ * @brief Slave device path (/dev/pts/N), "" if not open
+ */
+const char *UartPty_Path(void);
+
+/**
+ * @brief Link statistics
+ */
+void UartPty_GetStats(UartPty_Stats *stats);
+
+/**
+ * @brief Close the pty and remove the symlink
+ */
+void UartPty_Close(void);
+
+#endif // UART_PTY_H
@@ -0,0 +1,181 @@
+/**
+ * @file    motor_sim.c
+ * @brief   Simulated DC motors and encoders implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "motor_sim.h"
+#include "drivers/sensors/encoder.h"
+#include <math.h>
+
+#define MOTOR_SIM_DT_S      1e-6f       // One HAL mock step
+#define RAD_S_TO_RPM        9.5492966f  // 60 / (2 pi)
+
+/* Where each motor and its encoder are wired (pin_map.h) */
+typedef struct {
+    TIM_TypeDef *pwm_tim;
+    uint32_t pwm_channel;
+    GPIO_TypeDef *in1_port;
+    uint16_t in1_pin;
+    GPIO_TypeDef *in2_port;
+    uint16_t in2_pin;
+    GPIO_TypeDef *stby_port;
+    uint16_t stby_pin;
+    GPIO_TypeDef *enc_port;
+    uint16_t enc_pin;
+} MotorSim_Wiring;
+
+static const MotorSim_Wiring wiring[MOTOR_COUNT] = {
+    {MOTOR_0_PWM_TIMER, MOTOR_0_PWM_CHANNEL, MOTOR_0_IN1_PORT, MOTOR_0_IN1_PIN,
+     MOTOR_0_IN2_PORT, MOTOR_0_IN2_PIN, DRIVER_1_STBY_PORT, DRIVER_1_STBY_PIN,
+     ENCODER_0_PORT, ENCODER_0_PIN},
+    {MOTOR_1_PWM_TIMER, MOTOR_1_PWM_CHANNEL, MOTOR_1_IN1_PORT, MOTOR_1_IN1_PIN,
+     MOTOR_1_IN2_PORT, MOTOR_1_IN2_PIN, DRIVER_1_STBY_PORT, DRIVER_1_STBY_PIN,
+     ENCODER_1_PORT, ENCODER_1_PIN},
+    {MOTOR_2_PWM_TIMER, MOTOR_2_PWM_CHANNEL, MOTOR_2_IN1_PORT, MOTOR_2_IN1_PIN,
+     MOTOR_2_IN2_PORT, MOTOR_2_IN2_PIN, DRIVER_2_STBY_PORT, DRIVER_2_STBY_PIN,
+     ENCODER_2_PORT, ENCODER_2_PIN},
+    {MOTOR_3_PWM_TIMER, MOTOR_3_PWM_CHANNEL, MOTOR_3_IN1_PORT, MOTOR_3_IN1_PIN,
+     MOTOR_3_IN2_PORT, MOTOR_3_IN2_PIN, DRIVER_2_STBY_PORT, DRIVER_2_STBY_PIN,
+     ENCODER_3_PORT, ENCODER_3_PIN}
+};
+
+typedef struct {
+    MotorSim_Params p;
+    float current_a;
+    float omega;                // rad/s
+    double revolutions;
+    float voltage_v;
+    bool enc_high;
+    uint32_t edges;
+} MotorSim_Motor;
+
+static MotorSim_Motor motors[MOTOR_COUNT];
+
+void MotorSim_DefaultParams(MotorSim_Params *params)
+{
+    /* ~260 RPM no-load at 6 V, ~12% deadband, ~60 ms mechanical time constant */
+    params->supply_v = 6.0f;
+    params->resistance_ohm = 5.0f;
+    params->inductance_h = 2e-3f;
+    params->ke = 0.2f;
+    params->kt = 0.2f;
+    params->inertia = 4.8e-4f;
+    params->viscous = 1e-4f;
+    params->coulomb_nm = 0.02f;
+    params->static_nm = 0.03f;
+    params->load_nm = 0.0f;
+}
+
+void MotorSim_Init(void)
+{
+    for (uint8_t m = 0; m < MOTOR_COUNT; m++) {
+        motors[m] = (MotorSim_Motor){0};
+        MotorSim_DefaultParams(&motors[m].p);
+        HalMock_SetInput(wiring[m].enc_port, wiring[m].enc_pin, GPIO_PIN_RESET);
+    }
+    HalMock_AddStepHook(MotorSim_Step);
+}
+
+void MotorSim_SetParams(Motor_ID motor, const MotorSim_Params *params)
+{
+    if (motor >= MOTOR_COUNT) return;
+    motors[motor].p = *params;
+}
+
+void MotorSim_GetParams(Motor_ID motor, MotorSim_Params *params)
+{
+    if (motor >= MOTOR_COUNT) return;
+    *params = motors[motor].p;
+}
+
+void MotorSim_SetLoad(Motor_ID motor, float load_nm)
+{
+    if (motor >= MOTOR_COUNT) return;
+    motors[motor].p.load_nm = load_nm;
+}
+
+void MotorSim_GetState(Motor_ID motor, MotorSim_State *state)
+{
+    if (motor >= MOTOR_COUNT) return;
+    const MotorSim_Motor *s = &motors[motor];
+    state->voltage_v = s->voltage_v;
+    state->current_a = s->current_a;
+    state->speed_rpm = s->omega * RAD_S_TO_RPM;
+    state->revolutions = s->revolutions;
+    state->edges = s->edges;
+}
+
+/**
+ * @brief Driver output from the registers: average voltage, false if open (coast)
+ */
+static bool MotorSim_DriverOutput(const MotorSim_Wiring *w, float supply_v, float *voltage)
+{
+    bool in1 = (w->in1_port->ODR & w->in1_pin) != 0;
+    bool in2 = (w->in2_port->ODR & w->in2_pin) != 0;
+    bool stby = (w->stby_port->ODR & w->stby_pin) != 0;
+
+    *voltage = 0.0f;
+    if (!stby || (!in1 && !in2)) return false;      // Standby / stop: high impedance
+    if (in1 && in2) return true;                    // Short brake
+
+    const TIM_TypeDef *tim = w->pwm_tim;
+    float duty = 0.0f;
+    if ((tim->CR1 & TIM_CR1_CEN) && (tim->CCER & (1UL << w->pwm_channel))) {
+        uint32_t ccr = *(&tim->CCR1 + (w->pwm_channel >> 2U));
+        duty = (float)ccr / (float)(tim->ARR + 1U);
+        if (duty > 1.0f) duty = 1.0f;
+    }
+
+    *voltage = (in1 ? duty : -duty) * supply_v;
+    return true;
+}
+
+static void MotorSim_StepMotor(MotorSim_Motor *s, const MotorSim_Wiring *w)
+{
+    const MotorSim_Params *p = &s->p;
+    const float dt = MOTOR_SIM_DT_S;
+
+    /* Electrical */
+    bool closed = MotorSim_DriverOutput(w, p->supply_v, &s->voltage_v);
+    if (closed) {
+        s->current_a += (s->voltage_v - p->resistance_ohm * s->current_a - p->ke * s->omega) /
+                        p->inductance_h * dt;
+    } else {
+        s->current_a = 0.0f;
+    }
+
+    /* Mechanical, with stiction */
+    float drive = p->kt * s->current_a - p->load_nm;
+    float friction;
+    if (s->omega == 0.0f) {
+        if (fabsf(drive) <= p->static_nm) return;
+        friction = copysignf(p->coulomb_nm, drive);
+    } else {
+        friction = copysignf(p->coulomb_nm, s->omega) + p->viscous * s->omega;
+    }
+
+    float omega = s->omega + (drive - friction) / p->inertia * dt;
+    /* Friction stops the wheel, it never reverses it */
+    if (s->omega != 0.0f && (omega > 0.0f) != (s->omega > 0.0f)) omega = 0.0f;
+    s->omega = omega;
+    s->revolutions += (double)(omega * dt) / (2.0 * M_PI);
+
+    /* Slotted disk: low over the first half of each slot pitch (low at rest) */
+    double slots = s->revolutions * ENCODER_SLOTS_PER_REV;
+    bool high = (slots - floor(slots)) >= 0.5;
+    if (high != s->enc_high) {
+        s->enc_high = high;
+        if (high) s->edges++;
+        HalMock_SetInput(w->enc_port, w->enc_pin, high ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    }
+}
+
+void MotorSim_Step(uint64_t now_us)
+{
+    (void)now_us;
+    for (uint8_t m = 0; m < MOTOR_COUNT; m++) {
+        MotorSim_StepMotor(&motors[m], &wiring[m]);
+    }
+}
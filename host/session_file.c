@@ -0,0 +1,60 @@
+/**
+ * @file    session_file.c
+ * @brief   Session file reading and writing
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "session_file.h"
+#include <errno.h>
+#include <string.h>
+
+FILE *SessionFile_Create(const char *path)
+{
+    static const uint8_t header[SESSION_FILE_HEADER] = {
+        'B', 'P', 'R', 'C', SESSION_FILE_VERSION, 0, 0, 0
+    };
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return NULL;
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+        fclose(file);
+        return NULL;
+    }
+    return file;
+}
+
+bool SessionFile_Write(FILE *file, const uint8_t *records, size_t size)
+{
+    return fwrite(records, 1, size, file) == size;
+}
+
+FILE *SessionFile_Open(const char *path)
+{
+    uint8_t header[SESSION_FILE_HEADER];
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, SESSION_FILE_MAGIC, 4) != 0 || header[4] != SESSION_FILE_VERSION) {
+        fclose(file);
+        errno = EINVAL;
+        return NULL;
+    }
+    return file;
+}
+
+bool SessionFile_Next(FILE *file, SessionFile_Record *record)
+{
+    uint8_t header[RECORDER_HEADER_SIZE];
+
+    if (fread(header, 1, sizeof(header), file) != sizeof(header)) return false;
+
+    record->time_us = (uint32_t)header[0] | ((uint32_t)header[1] << 8) |
+                      ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 24);
+    record->dir = (Recorder_Dir)header[4];
+    record->len = header[5];
+    if (fread(record->line, 1, record->len, file) != record->len) return false;
+    record->line[record->len] = '\0';
+    return true;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file    uart_pty.c
+ * @brief   USART of the host build exposed as a Linux pseudo-terminal
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#define _GNU_SOURCE
+#include "uart_pty.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define UART_PTY_IDLE_POLL_US   1000    // Read attempt interval with nothing received
+#define UART_PTY_PACE_US        1000    // Wall clock check interval
+
+static int master_fd = -1;
+static int slave_fd = -1;              // Kept open: raw mode and no hang-up between clients
+static char slave_path[64];
+static char link_name[256];
+
+static USART_TypeDef *pty_usart;
+static bool pace_realtime;
+static UartPty_Stats stats;
+
+static uint8_t rx_buf[256];
+static size_t rx_len, rx_pos;
+static uint64_t next_rx_us;
+
+static bool reply_pending;             // Command line received, no byte sent since
+static uint64_t line_end_us;
+
+static struct timespec wall_start;
+static uint64_t next_pace_us;
+
+static void UartPty_Tx(const USART_TypeDef *usart, const uint8_t *data, uint16_t size)
+{
+    if (usart != pty_usart) return;
+
+    if (reply_pending) {
+        uint32_t latency = (uint32_t)(HalMock_NowUs() - line_end_us);
+        if (stats.latency_count == 0 || latency < stats.latency_min_us) stats.latency_min_us = latency;
+        if (latency > stats.latency_max_us) stats.latency_max_us = latency;
+        stats.latency_total_us += latency;
+        stats.latency_count++;
+        reply_pending = false;
+    }
+
+    ssize_t n = write(master_fd, data, size);
+    if (n < 0) n = 0;
+    stats.tx_bytes += (uint32_t)n;
+    stats.tx_lost += size - (uint32_t)n;
+}
+
+/**
+ * @brief Sleep while virtual time is ahead of the wall clock
+ */
+static void UartPty_Pace(uint64_t now_us)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t wall_us = (int64_t)(ts.tv_sec - wall_start.tv_sec) * 1000000 +
+                      (ts.tv_nsec - wall_start.tv_nsec) / 1000;
+    int64_t ahead_us = (int64_t)now_us - wall_us;
+    if (ahead_us > 0) {
+        struct timespec d = {(time_t)(ahead_us / 1000000), (long)(ahead_us % 1000000) * 1000};
+        nanosleep(&d, NULL);
+    }
+}
+
+/**
+ * @brief Step hook: one received character per character time, wall clock pacing
+ */
+static void UartPty_Step(uint64_t now_us)
+{
+    if (pace_realtime && now_us >= next_pace_us) {
+        next_pace_us = now_us + UART_PTY_PACE_US;
+        UartPty_Pace(now_us);
+    }
+
+    if (now_us < next_rx_us) return;
+
+    if (rx_pos >= rx_len) {
+        ssize_t n = read(master_fd, rx_buf, sizeof(rx_buf));
+        if (n <= 0) {
+            next_rx_us = now_us + UART_PTY_IDLE_POLL_US;
+            return;
+        }
+        rx_len = (size_t)n;
+        rx_pos = 0;
+    }
+
+    uint8_t byte = rx_buf[rx_pos++];
+    stats.rx_bytes++;
+    if (!HalMock_UartReceive(pty_usart, byte)) stats.rx_overruns++;
+    if (byte == '\n' && !reply_pending) {
+        reply_pending = true;
+        line_end_us = now_us;
+    }
+    next_rx_us = now_us + HalMock_UartByteTimeUs(pty_usart);
+}
+
+bool UartPty_Open(USART_TypeDef *usart, const char *link_path, uint32_t baud, bool realtime)
+{
+    master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0 ||
+        ptsname_r(master_fd, slave_path, sizeof(slave_path)) != 0) {
+        perror("uart_pty");
+        UartPty_Close();
+        return false;
+    }
+
+    /* Raw slave: no echo, no line editing, no CR/LF translation */
+    slave_fd = open(slave_path, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if (slave_fd < 0 || tcgetattr(slave_fd, &tio) != 0) {
+        perror("uart_pty");
+        UartPty_Close();
+        return false;
+    }
+    cfmakeraw(&tio);
+    cfsetspeed(&tio, B115200);
+    tcsetattr(slave_fd, TCSANOW, &tio);
+    fcntl(master_fd, F_SETFL, fcntl(master_fd, F_GETFL) | O_NONBLOCK);
+
+    link_name[0] = '\0';
+    if (link_path != NULL) {
+        unlink(link_path);
+        if (symlink(slave_path, link_path) == 0) {
+            snprintf(link_name, sizeof(link_name), "%s", link_path);
+        } else {
+            perror("uart_pty: symlink");
+        }
+    }
+
+    pty_usart = usart;
+    pace_realtime = realtime;
+    memset(&stats, 0, sizeof(stats));
+    rx_len = rx_pos = 0;
+    next_rx_us = 0;
+    reply_pending = false;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    /* Wall clock starts now, virtual time may already be past zero */
+    wall_start.tv_sec -= (time_t)(HalMock_NowUs() / 1000000U);
+    wall_start.tv_nsec -= (long)(HalMock_NowUs() % 1000000U) * 1000;
+    if (wall_start.tv_nsec < 0) {
+        wall_start.tv_nsec += 1000000000L;
+        wall_start.tv_sec--;
+    }
+    next_pace_us = 0;
+
+    HalMock_SetUartTiming(true, baud);
+    HalMock_SetTxHook(UartPty_Tx);
+    return HalMock_AddStepHook(UartPty_Step);
+}
+
+const char *UartPty_Path(void)
+{
+    return (master_fd >= 0) ? slave_path : "";
+}
+
+void UartPty_GetStats(UartPty_Stats *out)
+{
+    *out = stats;
+    out->tx_timeouts = (pty_usart != NULL) ? HalMock_UartTxTimeouts(pty_usart) : 0;
+}
+
+void UartPty_Close(void)
+{
+    if (link_name[0] != '\0') unlink(link_name);
+    link_name[0] = '\0';
+    if (slave_fd >= 0) close(slave_fd);
+    if (master_fd >= 0) close(master_fd);
+    slave_fd = master_fd = -1;
+    HalMock_SetTxHook(NULL);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file    app_tasks.h
+ * @brief   Application bring-up and scheduler tasks shared by main.c and the host build
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * main() and host/host_main.c both call App_Init() once the HAL, the clock
+ * profile and the timebase are up, then App_StartTasks(). The module init
+ * order, PWM timer setup, task bodies and task table therefore exist once.
+ */
+
+#ifndef APP_TASKS_H
+#define APP_TASKS_H
+
+#include "main.h"
+
+/* Motor PWM timers (1 MHz counter, 1 kHz PWM) */
+extern TIM_HandleTypeDef htim1; // Motor 2 (PWM на PA8)
+extern TIM_HandleTypeDef htim2; // Motor 3 (PWM на PA15)
+extern TIM_HandleTypeDef htim3; // Motor 0 (PWM на PB0)
+extern TIM_HandleTypeDef htim4; // Motor 1 (PWM на PB7)
+
+/**
+ * @brief Initialize diagnostics buffers, PWM timers, drivers, telemetry,
+ *        buttons, encoders, odometry and the speed controller (TIM9 starts)
+ * Call after HAL_Init, the clock profile, Timebase_Init and the GPIO clocks.
+ */
+void App_Init(void);
+
+/**
+ * @brief Register the main loop tasks, start command reception and the scheduler
+ */
+void App_StartTasks(void);
+
+#endif // APP_TASKS_H
@@ -0,0 +1,106 @@
+/**
+ * @file    autotune.h
+ * @brief   Relay-feedback (Astrom-Hagglund) PID auto-tuning per motor
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * The motor is driven open loop with a relay around a bias duty:
+ *   duty = bias + d  while RPM < setpoint - hysteresis
+ *   duty = bias - d  while RPM > setpoint + hysteresis
+ * The speed settles into a limit cycle whose amplitude a and period Tu give
+ * the ultimate gain Ku = 4d / (pi * sqrt(a^2 - h^2)). Ziegler-Nichols rules
+ * turn Ku/Tu into PI or PID gains that replace the speed controller gains
+ * (RAM only, feed-forward is kept).
+ *
+ * Stepped from SpeedControl_Tick(), so the relay runs at the control rate.
+ */
+
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include "main.h"
+#include "drivers/motor/tb6612fng.h"
+#include "speed_control.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Experiment defaults
+ * The relay centre comes from the feed-forward, which is only a guess
+ * until the motor is characterized (kff 0.15 %/RPM, no deadband). The
+ * relay must still swing the duty across the setpoint or no limit cycle
+ * forms: on the reference plant (host motor_sim: ~8 % deadband, 2.8 RPM
+ * per %) 20 % fails above ~80 RPM, 35 % oscillates from 40 to 160 RPM. */
+#define AUTOTUNE_RELAY_DEFAULT      35      // Relay amplitude d, duty %
+#define AUTOTUNE_HYSTERESIS_RPM     5.0f    // Switching hysteresis h (noise immunity)
+#define AUTOTUNE_SETTLE_MS          1000    // Bias-only phase before the relay starts
+#define AUTOTUNE_SKIP_CYCLES        2       // Transient cycles ignored
+#define AUTOTUNE_MEASURE_CYCLES     4       // Cycles averaged for Ku / Tu
+#define AUTOTUNE_TIMEOUT_MS         15000   // Abort if no limit cycle by then
+
+/* Tuning rule applied to Ku / Tu */
+typedef enum {
+    AUTOTUNE_RULE_PI  = 0,  // Kp = 0.45 Ku, Ti = Tu / 1.2
+    AUTOTUNE_RULE_PID = 1   // Kp = 0.60 Ku, Ti = Tu / 2, Td = Tu / 8
+} Autotune_Rule;
+
+/* Experiment state */
+typedef enum {
+    AUTOTUNE_IDLE = 0,
+    AUTOTUNE_SETTLING,
+    AUTOTUNE_RELAY,
+    AUTOTUNE_DONE,
+    AUTOTUNE_FAILED
+} Autotune_State;
+
+/* Experiment result */
+typedef struct {
+    Motor_ID motor;
+    Autotune_State state;       // AUTOTUNE_DONE or AUTOTUNE_FAILED
+    float ku;                   // Ultimate gain, duty % per RPM
+    float tu_s;                 // Ultimate period, s
+    float amplitude_rpm;        // Limit cycle amplitude a
+    SpeedControl_Gains gains;   // Gains stored in the speed controller
+} Autotune_Result;
+
+/**
+ * @brief Start relay experiment on a motor (closed loop is switched off)
+ * @param motor Motor ID (MOTOR_0 to MOTOR_3)
+ * @param setpoint_rpm Operating point, RPM (sign selects direction)
+ * @param relay_amplitude Relay amplitude d, duty % (0 = default)
+ * @param rule Tuning rule for the computed gains
+ * @return true if started (no other experiment running, valid arguments)
+ */
+bool Autotune_Start(Motor_ID motor, float setpoint_rpm, uint8_t relay_amplitude,
+                    Autotune_Rule rule);
+
+/**
+ * @brief Abort running experiment and stop its motor
+ */
+void Autotune_Abort(void);
+
+/**
+ * @brief Check if an experiment is in progress
+ * @return true while settling or relaying
+ */
+bool Autotune_IsRunning(void);
+
+/**
+ * @brief Check if an experiment is driving a motor
+ * @param motor Motor ID
+ * @return true while settling or relaying on that motor
+ */
+bool Autotune_IsTesting(Motor_ID motor);
+
+/**
+ * @brief Fetch result of a finished experiment (once)
+ * @param result Output result
+ * @return true if an experiment finished since the last call
+ */
+bool Autotune_PollResult(Autotune_Result *result);
+
+/**
+ * @brief Experiment step (called from SpeedControl_Tick)
+ */
+void Autotune_Tick(void);
+
+#endif // AUTOTUNE_H
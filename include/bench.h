@@ -0,0 +1,58 @@
+/**
+ * @file    bench.h
+ * @brief   Micro-benchmarks of telemetry, command parsing and control kernels
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Build with -DUSE_BENCH -DUSE_PROFILER (the profiler counter is the time
+ * base: DWT CYCCNT on the target, ns on the host). Every benchmark calls
+ * its kernel BENCH_ROUNDS x BENCH_BATCH times with varying inputs; each
+ * batch is timed as a whole with interrupts masked and divided by
+ * BENCH_BATCH, so min is the best batch and stays stable between runs.
+ *
+ * Telemetry is muted while a benchmark runs (formatting only, no wire
+ * time). Benchmarks drive the real modules: the speed loop is switched
+ * off and the motors are stopped before and after, driver benchmarks
+ * use duty 0. The firmware stalls for the duration (C:W, ~1 s).
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef USE_BENCH
+
+#ifndef USE_PROFILER
+#error "USE_BENCH needs USE_PROFILER (cycle counter)"
+#endif
+
+#define BENCH_ROUNDS    128     // Timed batches per benchmark
+#define BENCH_BATCH     8       // Calls per batch
+
+/* Result of one benchmark, cycles per call */
+typedef struct {
+    const char *name;
+    uint32_t iterations;        // BENCH_ROUNDS * BENCH_BATCH
+    uint32_t min;               // Best batch
+    uint32_t avg;
+    uint32_t max;               // Worst batch
+} Bench_Result;
+
+/**
+ * @brief Number of benchmarks
+ */
+uint8_t Bench_Count(void);
+
+/**
+ * @brief Run one benchmark
+ * @param index 0 .. Bench_Count() - 1
+ * @param result Output statistics
+ * @return false if the index is invalid
+ */
+bool Bench_Run(uint8_t index, Bench_Result *result);
+
+#endif // USE_BENCH
+
+#endif // BENCH_H
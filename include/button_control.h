@@ -6,42 +6,80 @@
  *
  * Maps 4 buttons to 4 motors with LED indicators
  * Logic: Hold button to run motor, release to stop
+ *
+ * All buttons are sampled bit-parallel: one IDR read per port gives a
+ * 4-bit vector (bit n = BTN_n pressed), debounced by 2-bit vertical
+ * counters (BUTTON_DEBOUNCE_SAMPLES equal samples to change state).
+ * A press edge (EXTI) is accepted at once for low latency; releases and
+ * missed edges go through the counters. ButtonControl_Update detects long
+ * presses and chords and consumes the resulting event queue.
  */
 
 #ifndef BUTTON_CONTROL_H
 #define BUTTON_CONTROL_H
 
 #include "main.h"
+#include "pin_map.h"
 #include "drivers/motor/tb6612fng.h"
+#include <stdbool.h>
+
+/* Button GPIO Pins (with internal pull-up), see pin_map.h */
+#define BTN_0_PORT      PINMAP_PORT(PIN_BTN_0)
+#define BTN_0_PIN       PINMAP_PIN(PIN_BTN_0)
+
+#define BTN_1_PORT      PINMAP_PORT(PIN_BTN_1)
+#define BTN_1_PIN       PINMAP_PIN(PIN_BTN_1)
+
+#define BTN_2_PORT      PINMAP_PORT(PIN_BTN_2)
+#define BTN_2_PIN       PINMAP_PIN(PIN_BTN_2)
+
+#define BTN_3_PORT      PINMAP_PORT(PIN_BTN_3)
+#define BTN_3_PIN       PINMAP_PIN(PIN_BTN_3)
 
-/* Button GPIO Pins (with internal pull-up) */
-#define BTN_0_PORT      GPIOB
-#define BTN_0_PIN       GPIO_PIN_3
+/* Bit-parallel sampling: BTN_0/1 share one port, BTN_2/3 another (one IDR read each) */
+#define BTN_SAMPLE_PORT_A       BTN_0_PORT
+#define BTN_SAMPLE_PORT_B       BTN_2_PORT
+#define BTN_SAMPLE_MASK_A       (BTN_0_PIN | BTN_1_PIN)
+#define BTN_SAMPLE_MASK_B       (BTN_2_PIN | BTN_3_PIN)
+#define BTN_ALL_MASK            ((1U << BUTTON_COUNT) - 1)
 
-#define BTN_1_PORT      GPIOB
-#define BTN_1_PIN       GPIO_PIN_4
+/* Active-low pin in an IDR snapshot -> pressed bit n */
+#define BTN_PRESSED_BIT(idr, pin, n)    ((uint8_t)((((idr) & (pin)) == 0) << (n)))
 
-#define BTN_2_PORT      GPIOC
-#define BTN_2_PIN       GPIO_PIN_14
+_Static_assert(PINMAP_PORT_INDEX(PIN_BTN_0) == PINMAP_PORT_INDEX(PIN_BTN_1) &&
+               PINMAP_PORT_INDEX(PIN_BTN_2) == PINMAP_PORT_INDEX(PIN_BTN_3),
+               "button_control.h: sampling expects BTN_0/1 and BTN_2/3 on shared ports");
 
-#define BTN_3_PORT      GPIOC
-#define BTN_3_PIN       GPIO_PIN_15
+/* Interrupt vectors below are fixed: BTN_0 on EXTI3, BTN_1 on EXTI4, BTN_2/3 on EXTI15_10 */
+_Static_assert(PINMAP_NUMBER(PIN_BTN_0) == 3 && PINMAP_NUMBER(PIN_BTN_1) == 4 &&
+               PINMAP_NUMBER(PIN_BTN_2) >= 10 && PINMAP_NUMBER(PIN_BTN_3) >= 10,
+               "button_control.h: button pins must stay on EXTI3, EXTI4 and EXTI15_10");
 
 /* LED GPIO Pins (optional indicators) */
-#define LED_0_PORT      GPIOA
-#define LED_0_PIN       GPIO_PIN_5
+#define LED_0_PORT      PINMAP_PORT(PIN_LED_0)
+#define LED_0_PIN       PINMAP_PIN(PIN_LED_0)
 
-#define LED_1_PORT      GPIOA
-#define LED_1_PIN       GPIO_PIN_6
+#define LED_1_PORT      PINMAP_PORT(PIN_LED_1)
+#define LED_1_PIN       PINMAP_PIN(PIN_LED_1)
 
-#define LED_2_PORT      GPIOA
-#define LED_2_PIN       GPIO_PIN_7
+#define LED_2_PORT      PINMAP_PORT(PIN_LED_2)
+#define LED_2_PIN       PINMAP_PIN(PIN_LED_2)
 
-#define LED_3_PORT      GPIOA
-#define LED_3_PIN       GPIO_PIN_11
+#define LED_3_PORT      PINMAP_PORT(PIN_LED_3)
+#define LED_3_PIN       PINMAP_PIN(PIN_LED_3)
 
 /* Motor control parameters */
 #define MOTOR_DEFAULT_SPEED     70      // Default speed (0-100%)
+#define MOTOR_LONG_PRESS_SPEED  100     // Speed after a long press (0-100%)
+
+/* Input timing */
+#define BUTTON_POLL_PERIOD_MS   5       // ButtonControl_Update period (scheduler task)
+#define BUTTON_DEBOUNCE_SAMPLES 4       // Vertical counter length (fixed, 2-bit)
+#define BUTTON_DEBOUNCE_MS      (BUTTON_POLL_PERIOD_MS * BUTTON_DEBOUNCE_SAMPLES)
+#define BUTTON_LONG_PRESS_MS    800     // Hold time for BUTTON_EVENT_LONG
+#define BUTTON_CHORD_WINDOW_MS  80      // Max press spread for BUTTON_EVENT_CHORD
+#define BUTTON_EVENT_QUEUE_SIZE 16      // Power of two
+#define BUTTON_IRQ_PRIORITY     6       // Below encoders (5)
 #define MOTOR_DIRECTION         MOTOR_FORWARD
 
 /* Button IDs */
@@ -53,24 +91,67 @@ typedef enum {
     BUTTON_COUNT = 4
 } Button_ID;
 
+/* Button event types */
+typedef enum {
+    BUTTON_EVENT_PRESS = 0,
+    BUTTON_EVENT_RELEASE,
+    BUTTON_EVENT_LONG,          // Held for BUTTON_LONG_PRESS_MS
+    BUTTON_EVENT_CHORD          // Several buttons pressed within the chord window
+} Button_EventType;
+
+/* Queued button event */
+typedef struct {
+    Button_EventType type;
+    uint8_t button;             // Button that triggered the event
+    uint8_t mask;               // Buttons held (bit per button) at event time
+    uint32_t time_us;           // Timebase_NowUs() of the event
+} Button_Event;
+
 /**
  * @brief Initialize buttons and LEDs GPIO
  */
 void ButtonControl_Init(void);
 
 /**
- * @brief Main control loop - call this in main while(1)
- * Reads button states and controls motors accordingly
+ * @brief Input task - call every BUTTON_POLL_PERIOD_MS (scheduler task)
+ * Finishes debounce, detects long presses, then consumes queued events
+ * and controls motors accordingly (non-blocking)
  */
 void ButtonControl_Update(void);
 
+/**
+ * @brief Take the next event from the queue
+ * @param event Output event
+ * @return true if an event was available
+ * @note ButtonControl_Update consumes the queue itself; use this only
+ *       when driving the buttons from another consumer
+ */
+bool ButtonControl_GetEvent(Button_Event *event);
+
+/**
+ * @brief Number of events dropped because the queue was full
+ */
+uint32_t ButtonControl_GetDroppedEvents(void);
+
 /**
  * @brief Check if button is pressed (active LOW with pull-up)
  * @param button_id Button to check (BUTTON_0 to BUTTON_3)
- * @return 1 if pressed, 0 if released
+ * @return 1 if pressed, 0 if released (raw level, not debounced)
  */
 uint8_t ButtonControl_IsPressed(Button_ID button_id);
 
+/**
+ * @brief Sample all buttons (one IDR read per port)
+ * @return Raw pressed vector, bit n = BTN_n pressed
+ */
+uint8_t ButtonControl_Sample(void);
+
+/**
+ * @brief Get debounced button states
+ * @return Bit n = BTN_n held
+ */
+uint8_t ButtonControl_GetState(void);
+
 /**
  * @brief Turn LED on
  * @param led_id LED number (0-3)
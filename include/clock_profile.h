@@ -0,0 +1,78 @@
+/**
+ * @file    clock_profile.h
+ * @brief   Runtime-selectable system clock profiles
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Each profile sets SYSCLK from the 25 MHz HSE through the PLL, the bus
+ * dividers, flash wait states and the core voltage scale. Switching a
+ * profile at runtime re-derives everything that depends on the clock:
+ * - registered timers keep a 1 MHz tick (PWM frequency, control rate);
+ * - USART1 keeps its baud rate;
+ * - SysTick keeps 1 ms (HAL_RCC_ClockConfig);
+ * - the TIM5 microsecond timebase keeps its count and 1 MHz rate.
+ */
+
+#ifndef CLOCK_PROFILE_H
+#define CLOCK_PROFILE_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CLOCK_TIMER_TICK_HZ         1000000UL   // Counter clock of all timers
+#define CLOCK_PROFILE_MAX_TIMERS    6
+
+/* Clock profiles */
+typedef enum {
+    CLOCK_PROFILE_PERFORMANCE = 0,  // 100 MHz, maximum headroom
+    CLOCK_PROFILE_BALANCED,         // 96 MHz (power-on default)
+    CLOCK_PROFILE_ECONOMY,          // 48 MHz, voltage scale 3
+    CLOCK_PROFILE_COUNT
+} Clock_Profile;
+
+#define CLOCK_PROFILE_DEFAULT       CLOCK_PROFILE_BALANCED
+
+/**
+ * @brief Configure the system clock at boot (call from SystemClock_Config)
+ * @param profile Profile to start with
+ */
+void ClockProfile_Init(Clock_Profile profile);
+
+/**
+ * @brief Register a timer that counts at CLOCK_TIMER_TICK_HZ
+ * Its prescaler is recomputed on every profile switch.
+ * @param htim Timer handle (Instance must be set)
+ * @return false if the table is full
+ */
+bool ClockProfile_AddTimer(TIM_HandleTypeDef *htim);
+
+/**
+ * @brief Switch profile at runtime and retime dependent peripherals
+ * @param profile New profile
+ * @return false if the profile is invalid or the RCC rejected it
+ */
+bool ClockProfile_Set(Clock_Profile profile);
+
+/**
+ * @brief Get the active profile
+ */
+Clock_Profile ClockProfile_Get(void);
+
+/**
+ * @brief Get profile name ("performance", "balanced", "economy")
+ */
+const char *ClockProfile_GetName(Clock_Profile profile);
+
+/**
+ * @brief Get the counter input clock of a timer, Hz
+ * APB timers run at 2 x PCLK when the APB divider is not 1.
+ */
+uint32_t ClockProfile_GetTimerClock(const TIM_TypeDef *tim);
+
+/**
+ * @brief Get the prescaler value for a CLOCK_TIMER_TICK_HZ counter
+ */
+uint32_t ClockProfile_GetTimerPrescaler(const TIM_TypeDef *tim);
+
+#endif // CLOCK_PROFILE_H
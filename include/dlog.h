@@ -0,0 +1,108 @@
+/**
+ * @file    dlog.h
+ * @brief   Deferred binary logging (format strings decoded on the host)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * DLOG(ID, args...) stores the message ID, a microsecond timestamp and up
+ * to DLOG_MAX_ARGS raw 32-bit arguments in a ring buffer - no formatting
+ * on the MCU. The format strings only exist in the table below: firmware
+ * code references the enum, so none of the text is linked into flash.
+ *
+ * The "log" task streams pending records as {"log":"hex"} lines;
+ * tools/dlog_decode.py reads this table and prints the text. Keep one
+ * X(...) per line. Arguments are integers; pass floats through DLOG_FLOAT()
+ * and use %f/%g in the format. Strings (%s) are not supported.
+ *
+ * Safe from ISRs and tasks. When the ring is full new messages are dropped
+ * and counted; the count is reported as a DROPPED message.
+ */
+
+#ifndef DLOG_H
+#define DLOG_H
+
+#include "main.h"
+#include <stdint.h>
+
+#define DLOG_BUFFER_WORDS   128     // Ring size, 32-bit words, power of 2
+#define DLOG_MAX_ARGS       4
+
+/* Message table: X(id, "printf format") */
+#define DLOG_MESSAGES(X)                                                                    \
+    X(DROPPED,          "%u log messages dropped")                                          \
+    X(TELEMETRY_INIT,   "UART telemetry: USART1 %u baud, PA9 (TX) / PA10 (RX) → ESP32-WROOM-32D") \
+    X(BUTTON_INIT,      "Button control: BTN_0-3 (PB3/PB4/PC14/PC15) → motor + LED 0-3, hold = %u%%") \
+    X(BUTTON_MODE,      "Button control mode active: hold BTN_0-3 to drive, release to stop") \
+    X(BUTTON_FORWARD,   "BTN_0 → FORWARD %u%%")                                             \
+    X(BUTTON_LEFT,      "BTN_1 → ROTATE LEFT %u%%")                                         \
+    X(BUTTON_RIGHT,     "BTN_2 → ROTATE RIGHT %u%%")                                        \
+    X(BUTTON_BACKWARD,  "BTN_3 → BACKWARD %u%%")                                            \
+    X(BUTTON_CHORD,     "CHORD 0x%X → BRAKE ALL")                                           \
+    X(BUTTON_RELEASE,   "BTN_%u released → STOP ALL")
+
+typedef enum {
+#define DLOG_ENUM_(id, fmt) DLOG_##id,
+    DLOG_MESSAGES(DLOG_ENUM_)
+#undef DLOG_ENUM_
+    DLOG_MESSAGE_COUNT
+} Dlog_Id;
+
+/*
+ * Record layout (little-endian words on the wire):
+ *   word 0: message ID (bits 0-15), argument count (bits 16-23)
+ *   word 1: Timebase_NowUs(), us
+ *   word 2..: arguments
+ */
+#define DLOG_HEADER_WORDS   2
+#define DLOG_RECORD_WORDS(nargs)    (DLOG_HEADER_WORDS + (nargs))
+
+_Static_assert((DLOG_BUFFER_WORDS & (DLOG_BUFFER_WORDS - 1)) == 0, "DLOG_BUFFER_WORDS must be a power of 2");
+
+/**
+ * @brief Log a message from the table with integer arguments
+ * Example: DLOG(BUTTON_RELEASE, ev.button);
+ */
+#define DLOG(id, ...)                                                           \
+    do {                                                                        \
+        const uint32_t dlog_args_[] = { 0, ##__VA_ARGS__ };                     \
+        _Static_assert(sizeof(dlog_args_) / sizeof(uint32_t) - 1 <= DLOG_MAX_ARGS, \
+                       "too many DLOG arguments");                              \
+        Dlog_Write(DLOG_##id, dlog_args_ + 1,                                   \
+                   (uint8_t)(sizeof(dlog_args_) / sizeof(uint32_t) - 1));       \
+    } while (0)
+
+/* Raw bits of a float argument (decoded for %f/%e/%g) */
+#define DLOG_FLOAT(x)   Dlog_FloatBits((float)(x))
+
+/**
+ * @brief Clear the ring
+ */
+void Dlog_Init(void);
+
+/**
+ * @brief Store one record (ISR-safe), use DLOG() instead
+ * @param id Message ID
+ * @param args Arguments
+ * @param nargs Argument count (0..DLOG_MAX_ARGS)
+ */
+void Dlog_Write(Dlog_Id id, const uint32_t *args, uint8_t nargs);
+
+/**
+ * @brief Take whole pending records, oldest first
+ * A DROPPED record follows once the ring is drained if messages were lost.
+ * @param out Output words
+ * @param max Capacity of out, words (at least DLOG_RECORD_WORDS(DLOG_MAX_ARGS))
+ * @return Words copied, 0 = nothing pending
+ */
+uint8_t Dlog_Read(uint32_t *out, uint8_t max);
+
+/**
+ * @brief Reinterpret a float as a 32-bit argument
+ */
+static inline uint32_t Dlog_FloatBits(float value)
+{
+    union { float f; uint32_t u; } bits = { .f = value };
+    return bits.u;
+}
+
+#endif // DLOG_H
@@ -0,0 +1,114 @@
+/**
+ * @file    isr_stats.h
+ * @brief   Interrupt latency, duration and jitter histograms
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Build with -DUSE_ISR_STATS to enable; otherwise the hooks are empty.
+ * Latency and duration are in core cycles (DWT CYCCNT), jitter in us
+ * (TIM5 timebase, which keeps counting in WFI). Values go into log2
+ * buckets: bucket 0 = 0, bucket k = [2^(k-1), 2^k), the last bucket is
+ * open-ended.
+ *
+ * - duration: handler entry to exit (includes preemption by higher
+ *   priority interrupts, i.e. the response time seen by that IRQ)
+ * - latency:  event to handler entry, only where hardware timestamps the
+ *   event: SysTick (exact, LOAD - VAL) and TIM9 (counter since update,
+ *   1 us resolution). EXTI and USART events carry no timestamp.
+ * - jitter:   |entry-to-entry interval - nominal period| of periodic IRQs, us
+ */
+
+#ifndef ISR_STATS_H
+#define ISR_STATS_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ISR_STATS_BUCKETS   20      // Last bucket >= 2^18 cycles (~2.7 ms at 96 MHz)
+
+/* Instrumented interrupts: X(id, name) */
+#define ISR_STATS_LIST(X)               \
+    X(ENCODER,  "encoder")  /* EXTI9_5, priority 5 */      \
+    X(BUTTON,   "button")   /* EXTI3/4/15_10, priority 6 */ \
+    X(UART,     "uart")     /* USART1, priority 1 */        \
+    X(CONTROL,  "control")  /* TIM9, priority 4, 500 Hz */  \
+    X(SYSTICK,  "systick")  /* SysTick, priority 0, 1 kHz */
+
+typedef enum {
+#define ISR_STATS_ENUM_(id, name) ISR_##id,
+    ISR_STATS_LIST(ISR_STATS_ENUM_)
+#undef ISR_STATS_ENUM_
+    ISR_COUNT
+} Isr_ID;
+
+/* Histogram kinds */
+typedef enum {
+    ISR_HIST_LATENCY = 0,
+    ISR_HIST_DURATION,
+    ISR_HIST_JITTER,
+    ISR_HIST_COUNT
+} Isr_HistKind;
+
+/* One histogram, cycles (jitter: us) */
+typedef struct {
+    uint32_t count;
+    uint32_t max;
+    uint32_t bucket[ISR_STATS_BUCKETS];
+} Isr_Histogram;
+
+#ifdef USE_ISR_STATS
+
+#define ISR_STATS_ENTER(id)                 uint32_t isr_entry_##id = IsrStats_Enter(ISR_##id)
+#define ISR_STATS_ENTER_LATENCY(id, cycles) uint32_t isr_entry_##id = IsrStats_EnterLatency(ISR_##id, (cycles))
+#define ISR_STATS_EXIT(id)                  IsrStats_Exit(ISR_##id, isr_entry_##id)
+
+/**
+ * @brief Enable the cycle counter and clear all histograms
+ * Call after Timebase_Init: jitter is not measured before this.
+ */
+void IsrStats_Init(void);
+
+/**
+ * @brief Handler entry (updates jitter of periodic IRQs)
+ * @return Entry timestamp for IsrStats_Exit
+ */
+uint32_t IsrStats_Enter(Isr_ID id);
+
+/**
+ * @brief Handler entry with a measured event-to-entry latency
+ * @param latency_cycles Latency, cycles
+ */
+uint32_t IsrStats_EnterLatency(Isr_ID id, uint32_t latency_cycles);
+
+/**
+ * @brief Handler exit
+ * @param entry Timestamp returned by IsrStats_Enter
+ */
+void IsrStats_Exit(Isr_ID id, uint32_t entry);
+
+/**
+ * @brief Copy a histogram
+ * @return false if the ID or kind is invalid
+ */
+bool IsrStats_Get(Isr_ID id, Isr_HistKind kind, Isr_Histogram *hist);
+
+/**
+ * @brief Get interrupt name
+ */
+const char *IsrStats_GetName(Isr_ID id);
+
+/**
+ * @brief Clear all histograms
+ */
+void IsrStats_Reset(void);
+
+#else
+
+#define ISR_STATS_ENTER(id)                 ((void)0)
+#define ISR_STATS_ENTER_LATENCY(id, cycles) ((void)0)
+#define ISR_STATS_EXIT(id)                  ((void)0)
+
+#endif // USE_ISR_STATS
+
+#endif // ISR_STATS_H
@@ -0,0 +1,47 @@
+/**
+ * @file    mem_stats.h
+ * @brief   Stack high-water mark and RAM usage reporting
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * RAM layout (linker script): .data | .bss | heap -> ... <- main stack.
+ * At startup the free gap between the heap top and the stack pointer is
+ * painted with MEM_STATS_PAINT; the deepest stack use is the lowest word
+ * above the heap top that no longer holds the pattern.
+ *
+ * Per-module static RAM comes from the linker map file:
+ *   python tools/ram_report.py .pio/build/blackpill_f411ce/firmware.map
+ */
+
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include "main.h"
+#include <stdint.h>
+
+#define MEM_STATS_PAINT         0xA5A5A5A5UL
+#define MEM_STATS_PAINT_MARGIN  64          // Bytes left unpainted below SP
+
+/* RAM usage snapshot, bytes */
+typedef struct {
+    uint32_t ram_total;         // Whole SRAM (_estack - _sdata)
+    uint32_t data;              // Initialized statics
+    uint32_t bss;               // Zero-initialized statics
+    uint32_t heap_used;         // Allocated by malloc (printf buffers etc.)
+    uint32_t heap_arena;        // Claimed from sbrk
+    uint32_t stack_used;        // Main stack high-water mark (incl. ISR frames)
+    uint32_t stack_free;        // Never touched gap between heap and stack
+} MemStats;
+
+/**
+ * @brief Paint the free stack area (first statement of main, before HAL_Init)
+ */
+void MemStats_PaintStack(void);
+
+/**
+ * @brief Take a RAM usage snapshot
+ * @param stats Output statistics
+ */
+void MemStats_Get(MemStats *stats);
+
+#endif // MEM_STATS_H
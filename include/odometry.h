@@ -0,0 +1,51 @@
+/**
+ * @file    odometry.h
+ * @brief   Wheel odometry and pose integration
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Integrates left/right side wheel travel from the encoders into
+ * x, y and heading (fixed point, no floating point in the update path).
+ * Left side = Motor 0/1, right side = Motor 2/3.
+ */
+
+#ifndef ODOMETRY_H
+#define ODOMETRY_H
+
+#include "main.h"
+#include <stdint.h>
+
+/* Robot geometry */
+#define ODOMETRY_WHEEL_DIAMETER_MM  65      // Wheel diameter
+#define ODOMETRY_TRACK_WIDTH_MM     150     // Distance between left and right wheels
+
+/* Pose snapshot (public units) */
+typedef struct {
+    int32_t x_mm;           // X position, mm (forward at reset)
+    int32_t y_mm;           // Y position, mm (left at reset)
+    int32_t heading_cdeg;   // Heading, 0.01 degree, range -18000..17999
+} Odometry_Pose;
+
+/**
+ * @brief Initialize odometry (pose = 0, 0, 0)
+ */
+void Odometry_Init(void);
+
+/**
+ * @brief Reset pose to origin and re-latch encoder counts
+ */
+void Odometry_Reset(void);
+
+/**
+ * @brief Integrate wheel travel since previous call
+ * @note Call at the control rate
+ */
+void Odometry_Update(void);
+
+/**
+ * @brief Get current pose
+ * @param pose Output pose snapshot
+ */
+void Odometry_GetPose(Odometry_Pose *pose);
+
+#endif // ODOMETRY_H
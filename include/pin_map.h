@@ -0,0 +1,209 @@
+/**
+ * @file    pin_map.h
+ * @brief   Board pin / timer resource map with compile-time conflict check
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Single source of truth for every GPIO, timer channel and EXTI line used
+ * by the firmware. Driver headers derive their *_PORT / *_PIN / *_CHANNEL
+ * / *_AF macros from here, and the static assertions at the bottom reject
+ * a build where two functions share a pin, a timer channel or an EXTI
+ * line, or where a timer pin selects the alternate function of another
+ * timer.
+ *
+ * Pin entry:   PIN_<NAME>  port, pin      (e.g. B, 6  = PB6)
+ * Timer entry: TIM_<NAME>  timer, channel (e.g. 4, 1  = TIM4_CH1;
+ *              channel 0 = whole timer used as a timebase, no pins)
+ * AF entry:    AF_<NAME>   GPIO alternate function of a timer pin
+ *              (AF1 = TIM1/2, AF2 = TIM3/4/5, AF3 = TIM9/10/11)
+ */
+
+#ifndef PIN_MAP_H
+#define PIN_MAP_H
+
+// ============================================================================
+// Motor Driver 1 (Motors 0, 1 - left side)
+// ============================================================================
+
+#define PIN_MOTOR_0_PWM         B, 0    // TIM3_CH3
+#define PIN_MOTOR_0_IN1         B, 1
+#define PIN_MOTOR_0_IN2         B, 10
+#define PIN_MOTOR_1_PWM         B, 7    // TIM4_CH2
+#define PIN_MOTOR_1_IN1         B, 12
+#define PIN_MOTOR_1_IN2         B, 13
+#define PIN_DRIVER_1_STBY       B, 14
+
+#define TIM_MOTOR_0_PWM         3, 3
+#define TIM_MOTOR_1_PWM         4, 2
+
+#define AF_MOTOR_0_PWM          2       // GPIO_AF2_TIM3
+#define AF_MOTOR_1_PWM          2       // GPIO_AF2_TIM4
+
+// ============================================================================
+// Motor Driver 2 (Motors 2, 3 - right side)
+// ============================================================================
+
+#define PIN_MOTOR_2_PWM         A, 8    // TIM1_CH1
+#define PIN_MOTOR_2_IN1         A, 0
+#define PIN_MOTOR_2_IN2         A, 1
+#define PIN_MOTOR_3_PWM         A, 15   // TIM2_CH1
+#define PIN_MOTOR_3_IN1         A, 2
+#define PIN_MOTOR_3_IN2         A, 3
+#define PIN_DRIVER_2_STBY       A, 4
+
+#define TIM_MOTOR_2_PWM         1, 1
+#define TIM_MOTOR_3_PWM         2, 1
+
+#define AF_MOTOR_2_PWM          1       // GPIO_AF1_TIM1
+#define AF_MOTOR_3_PWM          1       // GPIO_AF1_TIM2
+
+// ============================================================================
+// Optical Encoders (EXTI, all on EXTI9_5; pins are also timer-capture capable)
+// ============================================================================
+
+#define PIN_ENCODER_0           B, 6    // TIM4_CH1
+#define PIN_ENCODER_1           B, 5    // TIM3_CH2
+#define PIN_ENCODER_2           B, 8    // TIM10_CH1
+#define PIN_ENCODER_3           B, 9    // TIM11_CH1
+
+#define TIM_ENCODER_0           4, 1
+#define TIM_ENCODER_1           3, 2
+#define TIM_ENCODER_2           10, 1
+#define TIM_ENCODER_3           11, 1
+
+#define AF_ENCODER_0            2       // GPIO_AF2_TIM4
+#define AF_ENCODER_1            2       // GPIO_AF2_TIM3
+#define AF_ENCODER_2            3       // GPIO_AF3_TIM10
+#define AF_ENCODER_3            3       // GPIO_AF3_TIM11
+
+// ============================================================================
+// Timebases (internal, no pins)
+// ============================================================================
+
+#define TIM_CONTROL_TICK        9, 0    // Speed controller tick (speed_control.c)
+#define TIM_TIMEBASE            5, 0    // Free-running microsecond clock (timebase.c)
+
+// ============================================================================
+// Buttons, LEDs, UART, debug
+// ============================================================================
+
+#define PIN_BTN_0               B, 3
+#define PIN_BTN_1               B, 4
+#define PIN_BTN_2               C, 14
+#define PIN_BTN_3               C, 15
+
+#define PIN_LED_0               A, 5
+#define PIN_LED_1               A, 6
+#define PIN_LED_2               A, 7
+#define PIN_LED_3               A, 11
+#define PIN_LED_STATUS          C, 13
+
+#define PIN_UART_TX             A, 9    // USART1_TX
+#define PIN_UART_RX             A, 10   // USART1_RX
+
+#define PIN_SWDIO               A, 13
+#define PIN_SWCLK               A, 14
+
+// ============================================================================
+// Accessors (expand an entry into HAL constants)
+// ============================================================================
+
+#define PINMAP_PORT(...)            PINMAP_PORT_(__VA_ARGS__)
+#define PINMAP_PIN(...)             PINMAP_PIN_(__VA_ARGS__)
+#define PINMAP_NUMBER(...)          PINMAP_NUMBER_(__VA_ARGS__)
+#define PINMAP_TIM(...)             PINMAP_TIM_(__VA_ARGS__)
+#define PINMAP_CHANNEL(...)         PINMAP_CHANNEL_(__VA_ARGS__)
+#define PINMAP_PORT_INDEX(...)      PINMAP_PORT_INDEX_(__VA_ARGS__)
+
+#define PINMAP_PORT_(port, pin)         GPIO##port
+#define PINMAP_PIN_(port, pin)          ((uint16_t)(1U << (pin)))
+#define PINMAP_NUMBER_(port, pin)       (pin)
+#define PINMAP_TIM_(tim, ch)            TIM##tim
+#define PINMAP_CHANNEL_(tim, ch)        TIM_CHANNEL_##ch
+#define PINMAP_PORT_INDEX_(port, pin)   PINMAP_INDEX_##port
+
+// ============================================================================
+// Compile-time resource check
+// ============================================================================
+
+// Every pin in use (the check only sees what is listed here)
+#define PINMAP_USED_PINS(X) \
+    X(PIN_MOTOR_0_PWM)   X(PIN_MOTOR_0_IN1)   X(PIN_MOTOR_0_IN2)   \
+    X(PIN_MOTOR_1_PWM)   X(PIN_MOTOR_1_IN1)   X(PIN_MOTOR_1_IN2)   \
+    X(PIN_DRIVER_1_STBY)                                           \
+    X(PIN_MOTOR_2_PWM)   X(PIN_MOTOR_2_IN1)   X(PIN_MOTOR_2_IN2)   \
+    X(PIN_MOTOR_3_PWM)   X(PIN_MOTOR_3_IN1)   X(PIN_MOTOR_3_IN2)   \
+    X(PIN_DRIVER_2_STBY)                                           \
+    X(PIN_ENCODER_0)     X(PIN_ENCODER_1)                          \
+    X(PIN_ENCODER_2)     X(PIN_ENCODER_3)                          \
+    X(PIN_BTN_0)         X(PIN_BTN_1)                              \
+    X(PIN_BTN_2)         X(PIN_BTN_3)                              \
+    X(PIN_LED_0)         X(PIN_LED_1)                              \
+    X(PIN_LED_2)         X(PIN_LED_3)         X(PIN_LED_STATUS)    \
+    X(PIN_UART_TX)       X(PIN_UART_RX)                            \
+    X(PIN_SWDIO)         X(PIN_SWCLK)
+
+// Every timer channel in use (PWM outputs, reserved capture inputs, timebases)
+#define PINMAP_USED_TIMERS(X) \
+    X(TIM_MOTOR_0_PWM)   X(TIM_MOTOR_1_PWM)                        \
+    X(TIM_MOTOR_2_PWM)   X(TIM_MOTOR_3_PWM)                        \
+    X(TIM_ENCODER_0)     X(TIM_ENCODER_1)                          \
+    X(TIM_ENCODER_2)     X(TIM_ENCODER_3)                          \
+    X(TIM_CONTROL_TICK)  X(TIM_TIMEBASE)
+
+// Every pin driven by or reserved for a timer channel: X(pin, timer, af)
+#define PINMAP_TIMER_PINS(X) \
+    X(PIN_MOTOR_0_PWM, TIM_MOTOR_0_PWM, AF_MOTOR_0_PWM)            \
+    X(PIN_MOTOR_1_PWM, TIM_MOTOR_1_PWM, AF_MOTOR_1_PWM)            \
+    X(PIN_MOTOR_2_PWM, TIM_MOTOR_2_PWM, AF_MOTOR_2_PWM)            \
+    X(PIN_MOTOR_3_PWM, TIM_MOTOR_3_PWM, AF_MOTOR_3_PWM)            \
+    X(PIN_ENCODER_0,   TIM_ENCODER_0,   AF_ENCODER_0)              \
+    X(PIN_ENCODER_1,   TIM_ENCODER_1,   AF_ENCODER_1)              \
+    X(PIN_ENCODER_2,   TIM_ENCODER_2,   AF_ENCODER_2)              \
+    X(PIN_ENCODER_3,   TIM_ENCODER_3,   AF_ENCODER_3)
+
+// Every pin routed to EXTI (lines are shared between ports)
+#define PINMAP_USED_EXTI(X) \
+    X(PIN_ENCODER_0)     X(PIN_ENCODER_1)                          \
+    X(PIN_ENCODER_2)     X(PIN_ENCODER_3)                          \
+    X(PIN_BTN_0)         X(PIN_BTN_1)                              \
+    X(PIN_BTN_2)         X(PIN_BTN_3)
+
+#define PINMAP_INDEX_A                  0
+#define PINMAP_INDEX_B                  1
+#define PINMAP_INDEX_C                  2
+
+#define PINMAP_GPIO_BIT(...)        PINMAP_GPIO_BIT_(__VA_ARGS__)
+#define PINMAP_GPIO_BIT_(port, pin)     (1ULL << (PINMAP_INDEX_##port * 16 + (pin)))
+#define PINMAP_TIM_BIT(...)         PINMAP_TIM_BIT_(__VA_ARGS__)
+#define PINMAP_TIM_BIT_(tim, ch)        ((ch) == 0 ? (0xFULL << ((tim) * 4)) \
+                                                   : (1ULL << ((tim) * 4 + (ch) - 1)))
+#define PINMAP_EXTI_BIT(...)        (1UL << PINMAP_NUMBER(__VA_ARGS__))
+#define PINMAP_TIM_AF(...)          PINMAP_TIM_AF_(__VA_ARGS__)
+#define PINMAP_TIM_AF_(tim, ch)         ((tim) <= 2 ? 1 : (tim) <= 5 ? 2 : 3)
+
+// Disjoint bit masks have sum == OR; any overlap breaks that
+#define PINMAP_GPIO_SUM(...)        + PINMAP_GPIO_BIT(__VA_ARGS__)
+#define PINMAP_GPIO_OR(...)         | PINMAP_GPIO_BIT(__VA_ARGS__)
+#define PINMAP_TIM_SUM(...)         + PINMAP_TIM_BIT(__VA_ARGS__)
+#define PINMAP_TIM_OR(...)          | PINMAP_TIM_BIT(__VA_ARGS__)
+#define PINMAP_EXTI_SUM(...)        + PINMAP_EXTI_BIT(__VA_ARGS__)
+#define PINMAP_EXTI_OR(...)         | PINMAP_EXTI_BIT(__VA_ARGS__)
+
+_Static_assert((0ULL PINMAP_USED_PINS(PINMAP_GPIO_SUM)) ==
+               (0ULL PINMAP_USED_PINS(PINMAP_GPIO_OR)),
+               "pin_map.h: a GPIO pin is assigned to more than one function");
+_Static_assert((0ULL PINMAP_USED_TIMERS(PINMAP_TIM_SUM)) ==
+               (0ULL PINMAP_USED_TIMERS(PINMAP_TIM_OR)),
+               "pin_map.h: a timer channel is assigned to more than one function");
+_Static_assert((0UL PINMAP_USED_EXTI(PINMAP_EXTI_SUM)) ==
+               (0UL PINMAP_USED_EXTI(PINMAP_EXTI_OR)),
+               "pin_map.h: two EXTI inputs share the same line number");
+
+// One assertion per timer pin; the message names the pin entry
+#define PINMAP_AF_CHECK(pin, tim, af) \
+    _Static_assert((af) == PINMAP_TIM_AF(tim), \
+                   "pin_map.h: alternate function does not match the timer of " #pin);
+PINMAP_TIMER_PINS(PINMAP_AF_CHECK)
+
+#endif /* PIN_MAP_H */
@@ -0,0 +1,98 @@
+/**
+ * @file    profiler.h
+ * @brief   DWT cycle-counter profiling of named code regions
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Build with -DUSE_PROFILER to enable. Usage:
+ *   PROFILE_BEGIN(ENCODER_UPDATE);
+ *   ... code ...
+ *   PROFILE_END(ENCODER_UPDATE);
+ * Each region keeps count / min / max / total cycles. Without USE_PROFILER
+ * the macros expand to nothing and no table is allocated.
+ *
+ * On the target the time base is DWT CYCCNT (core cycles). On the host
+ * (no __arm__) it is CLOCK_MONOTONIC in ns, so the same instrumented code
+ * runs in host tests.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Profiled regions: X(id, name) */
+#define PROFILER_REGIONS(X)                          \
+    X(COMMAND,          "command")                   \
+    X(TELEMETRY_MOTOR,  "telemetry_motor")           \
+    X(BUTTON_UPDATE,    "button_update")             \
+    X(ENCODER_UPDATE,   "encoder_update")            \
+    X(CONTROL_TICK,     "control_tick")
+
+typedef enum {
+#define PROFILER_ENUM_(id, name) PROFILE_##id,
+    PROFILER_REGIONS(PROFILER_ENUM_)
+#undef PROFILER_ENUM_
+    PROFILE_COUNT
+} Profiler_Region;
+
+/* Statistics of one region, cycles */
+typedef struct {
+    const char *name;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} Profiler_Stats;
+
+#ifdef USE_PROFILER
+
+#if defined(__arm__)
+#include "main.h"
+static inline uint32_t Profiler_Now(void) { return DWT->CYCCNT; }
+#else
+uint32_t Profiler_Now(void);
+#endif
+
+#define PROFILE_BEGIN(id)   uint32_t profile_start_##id = Profiler_Now()
+#define PROFILE_END(id)     Profiler_Record(PROFILE_##id, Profiler_Now() - profile_start_##id)
+
+/**
+ * @brief Enable the cycle counter and clear statistics
+ */
+void Profiler_Init(void);
+
+/**
+ * @brief Add one measurement to a region (ISR-safe)
+ * @param region Region ID
+ * @param cycles Duration, cycles
+ */
+void Profiler_Record(Profiler_Region region, uint32_t cycles);
+
+/**
+ * @brief Get statistics of a region
+ * @param region Region ID
+ * @param stats Output statistics
+ * @return false if the ID is invalid
+ */
+bool Profiler_GetStats(Profiler_Region region, Profiler_Stats *stats);
+
+/**
+ * @brief Clear statistics of all regions
+ */
+void Profiler_Reset(void);
+
+/**
+ * @brief Counter ticks per microsecond (core MHz on target, 1000 on host)
+ */
+uint32_t Profiler_CyclesPerUs(void);
+
+#else
+
+#define PROFILE_BEGIN(id)   ((void)0)
+#define PROFILE_END(id)     ((void)0)
+
+#endif // USE_PROFILER
+
+#endif // PROFILER_H
@@ -0,0 +1,115 @@
+/**
+ * @file    recorder.h
+ * @brief   Session recorder: timestamped command and telemetry lines
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Build with -DUSE_RECORDER to enable; otherwise the hooks are empty.
+ * Every command line received on USART1 (RemoteCommand_ReceiveByte, also
+ * the ones dropped because the previous command was still pending) and
+ * every telemetry line sent (Telemetry_*) is stored with a Timebase_NowUs()
+ * timestamp in a byte ring of RECORDER_BUFFER_SIZE. The oldest records
+ * are overwritten, so the ring always holds the last seconds before a
+ * field problem (flight recorder).
+ *
+ * "C:G" dumps the ring as hex lines; tools/session.py turns the UART log
+ * into a session file, replays it on the host build and diffs telemetry.
+ * The host build drains the ring into a file as it runs (--record).
+ */
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RECORDER_BUFFER_SIZE    4096    // Ring size, bytes, power of 2
+
+/*
+ * Record layout (bytes, little-endian, no padding):
+ *   0..3  Timebase_NowUs(), us
+ *   4     direction (Recorder_Dir)
+ *   5     line length n (without '\n', longer lines are cut)
+ *   6..   n bytes of the line
+ */
+#define RECORDER_HEADER_SIZE    6
+#define RECORDER_MAX_LINE       255
+#define RECORDER_MAX_RECORD     (RECORDER_HEADER_SIZE + RECORDER_MAX_LINE)
+
+typedef enum {
+    RECORDER_IN  = 0,       // Command received
+    RECORDER_OUT = 1        // Telemetry sent
+} Recorder_Dir;
+
+_Static_assert((RECORDER_BUFFER_SIZE & (RECORDER_BUFFER_SIZE - 1)) == 0, "RECORDER_BUFFER_SIZE must be a power of 2");
+_Static_assert(RECORDER_BUFFER_SIZE >= 2 * RECORDER_MAX_RECORD, "RECORDER_BUFFER_SIZE too small");
+
+#ifdef USE_RECORDER
+
+#define RECORDER_INPUT(line, len)       Recorder_Input((line), (len))
+#define RECORDER_OUTPUT(data, len)      Recorder_Output((data), (len))
+
+/**
+ * @brief Clear the ring
+ */
+void Recorder_Init(void);
+
+/**
+ * @brief Store a received command line (ISR-safe)
+ * @param line Line without the terminator
+ * @param len Length
+ */
+void Recorder_Input(const char *line, uint16_t len);
+
+/**
+ * @brief Store sent telemetry; bytes are collected until '\n' and stored
+ *        as one record per line (task context)
+ */
+void Recorder_Output(const char *data, uint16_t len);
+
+/**
+ * @brief Drop all records and the lost count
+ */
+void Recorder_Clear(void);
+
+/**
+ * @brief Take whole records out of the ring, oldest first
+ * @param out Output buffer, at least RECORDER_MAX_RECORD bytes
+ * @param max Capacity of out
+ * @return Bytes copied (0 = ring empty)
+ */
+uint16_t Recorder_Read(uint8_t *out, uint16_t max);
+
+/**
+ * @brief Records overwritten before they were read, since the last clear
+ */
+uint32_t Recorder_GetLost(void);
+
+/**
+ * @brief Freeze recording and start reading out the ring
+ * @param lost Output: records overwritten since the last clear/dump
+ * @return Bytes to read
+ */
+uint32_t Recorder_BeginDump(uint32_t *lost);
+
+/**
+ * @brief Read the next bytes of a dump (records may span calls)
+ * Recording resumes (ring empty) once everything was read.
+ * @return Bytes copied, 0 = dump finished or none in progress
+ */
+uint16_t Recorder_ReadDump(uint8_t *out, uint16_t max);
+
+/**
+ * @brief Check whether a dump is in progress
+ */
+bool Recorder_IsDumping(void);
+
+#else
+
+#define RECORDER_INPUT(line, len)       ((void)0)
+#define RECORDER_OUTPUT(data, len)      ((void)0)
+
+#endif // USE_RECORDER
+
+#endif // RECORDER_H
@@ -0,0 +1,62 @@
+/**
+ * @file    remote_command.h
+ * @brief   UART command interface (from ESP32)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * The USART1 RX interrupt assembles "C:..." lines one byte at a time and
+ * wakes the command task, which parses and executes the line (see
+ * RemoteCommand_Execute in remote_command.c for the command list).
+ * Split from main.c so the handler also builds in the native environment.
+ */
+
+#ifndef REMOTE_COMMAND_H
+#define REMOTE_COMMAND_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define REMOTE_COMMAND_MAX_LEN  64      // Line buffer incl. terminator
+
+/* Reception counters since boot */
+typedef struct {
+    uint32_t lines;             // Non-empty lines received
+    uint32_t dropped;           // Lost: previous command still pending
+} RemoteCommand_Stats;
+
+/**
+ * @brief Start interrupt-driven reception
+ * @param task Scheduler task to notify when a line is complete (-1 = none)
+ */
+void RemoteCommand_Start(int8_t task);
+
+/**
+ * @brief Feed one received byte (called from the RX interrupt)
+ * @param c Received character, '\n' ends the line, '\r' is ignored
+ * @return true if a complete command was queued for RemoteCommand_Process
+ */
+bool RemoteCommand_ReceiveByte(char c);
+
+/**
+ * @brief Execute the queued command, if any (scheduler task)
+ */
+void RemoteCommand_Process(void);
+
+/**
+ * @brief Parse and execute one command line
+ * @param cmd Null-terminated line without the newline, e.g. "C:F:70"
+ */
+void RemoteCommand_Execute(const char *cmd);
+
+/**
+ * @brief Reception counters (lines received / dropped)
+ */
+void RemoteCommand_GetStats(RemoteCommand_Stats *stats);
+
+/**
+ * @brief Send current odometry pose (also used by the heartbeat task)
+ */
+void RemoteCommand_SendPose(void);
+
+#endif // REMOTE_COMMAND_H
@@ -0,0 +1,142 @@
+/**
+ * @file    scheduler.h
+ * @brief   Time-triggered cooperative task scheduler
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Periodic tasks are released at phase + k * period (TIM5 microsecond
+ * timebase, see timebase.h) and run to completion in registration order
+ * (first registered = highest priority). Run time, idle time and wake-up
+ * latency come from the same timebase, which keeps counting in WFI. A run
+ * longer than the task budget counts as an overrun, a release that could
+ * not be served before the next one counts as a missed release.
+ *
+ * Hard real-time work (speed control) stays in the TIM9 interrupt.
+ *
+ * When nothing is due the loop sleeps in WFI (any enabled interrupt wakes
+ * it: SysTick, UART, TIM, EXTI, DMA). An ISR can make a task due at once
+ * with Scheduler_Notify; notified tasks run before periodic ones. Since
+ * every budget is <= SCHEDULER_WAKE_LATENCY_US, a notified task starts
+ * within that bound unless another task overruns (counted as a violation).
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHEDULER_MAX_TASKS         8
+#define SCHEDULER_WAKE_LATENCY_US   10000   // Notify -> task start bound (max budget)
+#define SCHEDULER_LOAD_WINDOW_MS    1000    // Idle accounting window
+
+/* Task entry point */
+typedef void (*Scheduler_TaskFn)(void);
+
+/* Per-task run-time statistics */
+typedef struct {
+    const char *name;
+    uint32_t period_ms;
+    uint32_t budget_us;
+    uint32_t runs;
+    uint32_t overruns;          // Runs longer than budget
+    uint32_t missed;            // Releases skipped because the task was late
+    uint32_t last_us;           // Duration of the last run
+    uint32_t max_us;            // Longest run
+    uint64_t total_us;          // Sum of run durations (avg = total / runs)
+    uint32_t max_lateness_us;   // Largest start delay after release
+} Scheduler_TaskStats;
+
+/* Idle / wake-up statistics */
+typedef struct {
+    uint8_t idle_percent;           // Time in WFI over the last window
+    uint32_t sleeps;                // WFI entries in the last window
+    uint32_t wake_latency_max_us;   // Longest Notify -> task start
+    uint32_t latency_violations;    // Starts later than SCHEDULER_WAKE_LATENCY_US
+} Scheduler_IdleStats;
+
+/* CPU load of the last window */
+typedef struct {
+    uint8_t cpu_percent;            // 100 - idle
+    uint32_t loops;                 // Main loop iterations (Dispatch calls)
+    uint32_t loop_min_us;           // Loop period, including sleep
+    uint32_t loop_avg_us;
+    uint32_t loop_max_us;
+    uint32_t longest_us;            // Longest single task run (blocking call)
+    const char *longest_task;
+} Scheduler_LoadStats;
+
+/**
+ * @brief Initialize scheduler (empty task table)
+ */
+void Scheduler_Init(void);
+
+/**
+ * @brief Register a periodic task
+ * @param name Task name (static string, used in statistics)
+ * @param fn Task function (must not block)
+ * @param period_ms Release period, ms
+ * @param phase_ms Offset of the first release, ms (spreads tasks apart)
+ * @param budget_us Allowed run time, us (0 = SCHEDULER_WAKE_LATENCY_US)
+ * @return Task ID, or -1 if the table is full or the budget exceeds
+ *         SCHEDULER_WAKE_LATENCY_US
+ */
+int8_t Scheduler_AddTask(const char *name, Scheduler_TaskFn fn,
+                         uint32_t period_ms, uint32_t phase_ms, uint32_t budget_us);
+
+/**
+ * @brief Align all releases to now (call once before the dispatch loop)
+ */
+void Scheduler_Start(void);
+
+/**
+ * @brief Run every task whose release time has come
+ * @return Number of tasks run (0 = idle pass)
+ */
+uint8_t Scheduler_Dispatch(void);
+
+/**
+ * @brief Make a task due now (ISR-safe, e.g. UART command received)
+ * @param id Task ID
+ */
+void Scheduler_Notify(int8_t id);
+
+/**
+ * @brief Sleep in WFI until the next interrupt unless a task was notified
+ * Call when Scheduler_Dispatch returned 0
+ */
+void Scheduler_Idle(void);
+
+/**
+ * @brief Get idle and wake-up statistics
+ * @param stats Output statistics
+ */
+void Scheduler_GetIdleStats(Scheduler_IdleStats *stats);
+
+/**
+ * @brief Get CPU load and loop timing of the last window
+ * Updated every SCHEDULER_LOAD_WINDOW_MS, also when the loop never idles.
+ * @param stats Output statistics
+ */
+void Scheduler_GetLoadStats(Scheduler_LoadStats *stats);
+
+/**
+ * @brief Get number of registered tasks
+ */
+uint8_t Scheduler_GetTaskCount(void);
+
+/**
+ * @brief Get statistics of a task
+ * @param id Task ID
+ * @param stats Output statistics
+ * @return false if the ID is invalid
+ */
+bool Scheduler_GetStats(uint8_t id, Scheduler_TaskStats *stats);
+
+/**
+ * @brief Clear statistics of all tasks and wake-up statistics
+ */
+void Scheduler_ResetStats(void);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,111 @@
+/**
+ * @file    speed_control.h
+ * @brief   Closed-loop per-motor PID speed controller
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Runs from the TIM9 update interrupt at SPEED_CONTROL_RATE_HZ:
+ * Encoder_Update -> PI(D) + feed-forward per motor -> TB6612FNG_Drive.
+ * Encoders are single-channel, so the loop works on speed magnitude and
+ * the setpoint sign selects the direction.
+ */
+
+#ifndef SPEED_CONTROL_H
+#define SPEED_CONTROL_H
+
+#include "main.h"
+#include "drivers/motor/tb6612fng.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Control loop rate (TIM9 update) */
+#define SPEED_CONTROL_RATE_HZ       500
+#define SPEED_CONTROL_IRQ_PRIORITY  4       // Above encoder EXTI (5), below UART (1)
+
+/* Default gains (duty % per RPM) */
+#define SPEED_CONTROL_KP_DEFAULT    0.10f
+#define SPEED_CONTROL_KI_DEFAULT    0.50f   // %/(RPM*s)
+#define SPEED_CONTROL_KD_DEFAULT    0.0f    // %*s/RPM
+#define SPEED_CONTROL_KFF_DEFAULT   0.15f   // Feed-forward, % per RPM of setpoint
+
+/* Output limits, duty % */
+#define SPEED_CONTROL_OUT_MAX       100.0f
+
+/* Feed-forward direction index (setpoint sign) */
+#define SPEED_CONTROL_FWD           0
+#define SPEED_CONTROL_REV           1
+
+/* Controller gains for one motor */
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+    float kff[2];       // Feed-forward slope per direction, % per RPM
+    float deadband[2];  // Feed-forward offset per direction, % (duty at which the wheel starts)
+} SpeedControl_Gains;
+
+/**
+ * @brief Initialize controllers and start TIM9 control tick
+ */
+void SpeedControl_Init(void);
+
+/**
+ * @brief Set speed setpoint and enable closed loop for a motor
+ * @param motor Motor ID (MOTOR_0 to MOTOR_3)
+ * @param rpm Setpoint, RPM (negative = reverse, 0 = stop)
+ */
+void SpeedControl_SetRPM(Motor_ID motor, float rpm);
+
+/**
+ * @brief Get current setpoint
+ * @param motor Motor ID
+ * @return Setpoint, RPM (0 if closed loop is disabled)
+ */
+float SpeedControl_GetSetpoint(Motor_ID motor);
+
+/**
+ * @brief Get last controller output
+ * @param motor Motor ID
+ * @return Duty, % (0-100)
+ */
+float SpeedControl_GetOutput(Motor_ID motor);
+
+/**
+ * @brief Disable closed loop for a motor (motor keeps its last drive state)
+ * @param motor Motor ID
+ */
+void SpeedControl_Disable(Motor_ID motor);
+
+/**
+ * @brief Disable closed loop and wheel synchronization for all motors,
+ *        abort auto-tune and characterization (manual / button control)
+ */
+void SpeedControl_DisableAll(void);
+
+/**
+ * @brief Check if closed loop is active for a motor
+ * @param motor Motor ID
+ * @return true if enabled
+ */
+bool SpeedControl_IsEnabled(Motor_ID motor);
+
+/**
+ * @brief Set controller gains for a motor
+ * @param motor Motor ID
+ * @param gains New gains (integrator is reset)
+ */
+void SpeedControl_SetGains(Motor_ID motor, const SpeedControl_Gains *gains);
+
+/**
+ * @brief Get controller gains for a motor
+ * @param motor Motor ID
+ * @param gains Output gains
+ */
+void SpeedControl_GetGains(Motor_ID motor, SpeedControl_Gains *gains);
+
+/**
+ * @brief Control tick (called from TIM9 interrupt)
+ */
+void SpeedControl_Tick(void);
+
+#endif // SPEED_CONTROL_H
@@ -0,0 +1,83 @@
+/**
+ * @file    timebase.h
+ * @brief   Free-running microsecond timebase (TIM5)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * TIM5 is a 32-bit timer counting at 1 MHz from boot; its overflow
+ * interrupt extends it to 64 bits. Unlike DWT CYCCNT it keeps counting in
+ * WFI and its rate does not change with the clock profile, unlike the
+ * HAL tick it resolves 1 us.
+ *
+ * 32-bit timestamps wrap every ~71 min: compare them only through
+ * differences (Timebase_ElapsedUs, Timebase_Expired), which are valid for
+ * intervals up to ~35 min. Use Timebase_NowUs64 for absolute time.
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include "main.h"
+#include "pin_map.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TIMEBASE_TIM            PINMAP_TIM(TIM_TIMEBASE)
+#define TIMEBASE_IRQ_PRIORITY   0       // Overflow only (every ~71 min), a few cycles
+
+/**
+ * @brief Start TIM5 at 1 MHz (call after SystemClock_Config)
+ */
+void Timebase_Init(void);
+
+/**
+ * @brief Reload the prescaler for the current timer clock
+ * The count is preserved; called by clock_profile.c at every SYSCLK
+ * change of a profile switch (no-op before Timebase_Init).
+ */
+void Timebase_Retime(void);
+
+/**
+ * @brief Current time, us (32-bit, wraps every ~71 min, ISR-safe)
+ */
+static inline uint32_t Timebase_NowUs(void)
+{
+    return TIMEBASE_TIM->CNT;
+}
+
+/**
+ * @brief Current time since boot, us (64-bit, ISR-safe)
+ */
+uint64_t Timebase_NowUs64(void);
+
+/**
+ * @brief Time since an earlier Timebase_NowUs() timestamp, us
+ */
+static inline uint32_t Timebase_ElapsedUs(uint32_t since_us)
+{
+    return Timebase_NowUs() - since_us;
+}
+
+/**
+ * @brief Deadline timeout_us from now (check with Timebase_Expired)
+ */
+static inline uint32_t Timebase_Deadline(uint32_t timeout_us)
+{
+    return Timebase_NowUs() + timeout_us;
+}
+
+/**
+ * @brief Check whether a deadline has passed (wrap-safe)
+ */
+static inline bool Timebase_Expired(uint32_t deadline_us)
+{
+    return (int32_t)(Timebase_NowUs() - deadline_us) >= 0;
+}
+
+/**
+ * @brief Busy-wait
+ * @param us Delay, us
+ */
+void Timebase_DelayUs(uint32_t us);
+
+#endif // TIMEBASE_H
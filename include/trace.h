@@ -0,0 +1,110 @@
+/**
+ * @file    trace.h
+ * @brief   Binary event trace ring buffer
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Build with -DUSE_TRACE to enable; otherwise TRACE() expands to nothing.
+ * TRACE(EVENT, arg0, arg1) stores a 12-byte record (timestamp in us from
+ * the TIM5 timebase, event ID, two arguments) in a ring of
+ * TRACE_BUFFER_SIZE records; the oldest records are overwritten. Safe from
+ * ISRs and tasks. The timebase keeps counting in WFI and its rate does not
+ * depend on the clock profile, unlike DWT CYCCNT.
+ *
+ * "C:Y" dumps the ring as hex lines; tools/trace2perfetto.py turns the
+ * captured UART log into Chrome trace / Perfetto JSON. The tool reads the
+ * event table below, so keep one X(...) per line.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TRACE_BUFFER_SIZE   256     // Records, power of 2 (12 bytes each)
+
+/* Event table: X(id, kind, name, track); BEGIN/END pairs become slices */
+#define TRACE_EVENTS(X)                                         \
+    X(TASK_BEGIN,    TRACE_BEGIN,   "task",         "main")     \
+    X(TASK_END,      TRACE_END,     "task",         "main")     \
+    X(CONTROL_BEGIN, TRACE_BEGIN,   "control_tick", "tim9")     \
+    X(CONTROL_END,   TRACE_END,     "control_tick", "tim9")     \
+    X(UART_RX,       TRACE_INSTANT, "uart_rx",      "uart")     \
+    X(COMMAND,       TRACE_INSTANT, "command",      "main")     \
+    X(NOTIFY,        TRACE_INSTANT, "notify",       "uart")     \
+    X(BUTTON,        TRACE_INSTANT, "button",       "input")    \
+    X(MOTOR,         TRACE_INSTANT, "motor",        "motor")
+
+/* Event kinds (used by the host tool) */
+#define TRACE_INSTANT   0
+#define TRACE_BEGIN     1
+#define TRACE_END       2
+
+typedef enum {
+#define TRACE_ENUM_(id, kind, name, track) TRACE_##id,
+    TRACE_EVENTS(TRACE_ENUM_)
+#undef TRACE_ENUM_
+    TRACE_EVENT_COUNT
+} Trace_Event;
+
+/* One record, little-endian on the wire */
+typedef struct {
+    uint32_t timestamp;     // Timebase_NowUs()
+    uint16_t event;         // Trace_Event
+    uint16_t arg0;
+    uint32_t arg1;
+} Trace_Entry;
+
+_Static_assert(sizeof(Trace_Entry) == 12, "Trace_Entry must stay 12 bytes (host tool format)");
+_Static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0, "TRACE_BUFFER_SIZE must be a power of 2");
+
+#ifdef USE_TRACE
+
+#define TRACE(id, arg0, arg1)   Trace_Record(TRACE_##id, (uint16_t)(arg0), (uint32_t)(arg1))
+
+/**
+ * @brief Clear the ring
+ * Call after Timebase_Init; nothing may be traced before it.
+ */
+void Trace_Init(void);
+
+/**
+ * @brief Store one record (ISR-safe)
+ */
+void Trace_Record(Trace_Event event, uint16_t arg0, uint32_t arg1);
+
+/**
+ * @brief Drop all records
+ */
+void Trace_Clear(void);
+
+/**
+ * @brief Freeze recording and start reading out the ring
+ * @param lost Output: records overwritten since the last clear/dump
+ * @return Number of records to read
+ */
+uint32_t Trace_BeginDump(uint32_t *lost);
+
+/**
+ * @brief Read the next records of a dump, oldest first
+ * Recording resumes (ring cleared) once everything was read.
+ * @param out Output records
+ * @param max Capacity of out
+ * @return Records copied, 0 = dump finished or none in progress
+ */
+uint8_t Trace_ReadDump(Trace_Entry *out, uint8_t max);
+
+/**
+ * @brief Check whether a dump is in progress
+ */
+bool Trace_IsDumping(void);
+
+#else
+
+#define TRACE(id, arg0, arg1)   ((void)0)
+
+#endif // USE_TRACE
+
+#endif // TRACE_H
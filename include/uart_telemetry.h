@@ -12,19 +12,24 @@
 #define UART_TELEMETRY_H
 
 #include "main.h"
+#include "pin_map.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 /* UART Configuration */
 #define TELEMETRY_UART          USART1
 #define TELEMETRY_BAUD_RATE     115200
 
 /* UART GPIO Pins */
-#define TELEMETRY_TX_PIN        GPIO_PIN_9   // PA9
-#define TELEMETRY_RX_PIN        GPIO_PIN_10  // PA10
-#define TELEMETRY_GPIO_PORT     GPIOA
+#define TELEMETRY_TX_PIN        PINMAP_PIN(PIN_UART_TX)   // PA9
+#define TELEMETRY_RX_PIN        PINMAP_PIN(PIN_UART_RX)   // PA10
+#define TELEMETRY_GPIO_PORT     PINMAP_PORT(PIN_UART_TX)
 
 /* JSON Buffer Size */
 #define TELEMETRY_BUFFER_SIZE   256
+#define TELEMETRY_TRACE_RECORDS 3       // Trace records per line (~82 bytes, < 10 ms at 115200)
+#define TELEMETRY_LOG_WORDS     10      // Log words per line (~90 bytes), >= one full record
+#define TELEMETRY_RECORDER_BYTES 48     // Session recorder bytes per line (~106 bytes)
 
 /* UART Handle (external declaration) */
 extern UART_HandleTypeDef huart1;
@@ -63,6 +68,190 @@ void Telemetry_SendAllMotors(uint8_t* motor_states, uint8_t* motor_speeds);
  */
 void Telemetry_SendRPM(uint8_t motor_id, float rpm);
 
+/**
+ * @brief Send encoder status (filtered RPM and rejected glitch edges)
+ * @param encoder_id Encoder number (0-3)
+ * @param rpm Filtered RPM value
+ * @param glitches Number of edges rejected by the minimum-period filter
+ */
+void Telemetry_SendEncoder(uint8_t encoder_id, float rpm, uint32_t glitches);
+
+/**
+ * @brief Send odometry pose
+ * @param x_mm X position, mm
+ * @param y_mm Y position, mm
+ * @param heading_cdeg Heading, 0.01 degree
+ */
+void Telemetry_SendPose(int32_t x_mm, int32_t y_mm, int32_t heading_cdeg);
+
+/**
+ * @brief Send closed-loop speed controller state
+ * @param motor_id Motor number (0-3)
+ * @param setpoint Setpoint, RPM (negative = reverse)
+ * @param rpm Measured RPM
+ * @param duty Controller output, %
+ */
+void Telemetry_SendSpeed(uint8_t motor_id, float setpoint, float rpm, float duty);
+
+/**
+ * @brief Send relay auto-tune result
+ * @param motor_id Motor number (0-3)
+ * @param success 1 if a limit cycle was identified and gains were stored
+ * @param ku Ultimate gain, duty % per RPM
+ * @param tu_s Ultimate period, s
+ * @param kp Tuned proportional gain
+ * @param ki Tuned integral gain
+ * @param kd Tuned derivative gain
+ */
+void Telemetry_SendAutotune(uint8_t motor_id, uint8_t success, float ku, float tu_s,
+                            float kp, float ki, float kd);
+
+/**
+ * @brief Send motor calibration table (index 0 = forward, 1 = reverse)
+ * @param motor_id Motor number (0-3)
+ * @param valid 1 if the sweep produced a usable fit
+ * @param deadband Duty % at 0 RPM of the fitted line
+ * @param slope RPM per duty %
+ * @param tau_ms Step response time constant, ms
+ * @param max_rpm RPM at 100% duty
+ * @param asymmetry Forward/reverse slope difference, %
+ */
+void Telemetry_SendCalibration(uint8_t motor_id, uint8_t valid, const float* deadband,
+                               const float* slope, const uint16_t* tau_ms,
+                               const float* max_rpm, float asymmetry);
+
+/**
+ * @brief Send scheduler task statistics
+ * @param task_id Task ID
+ * @param name Task name
+ * @param runs Number of runs
+ * @param avg_us Average run time, us
+ * @param max_us Longest run time, us
+ * @param overruns Runs longer than the budget
+ * @param missed Skipped releases
+ */
+void Telemetry_SendTask(uint8_t task_id, const char* name, uint32_t runs, uint32_t avg_us,
+                        uint32_t max_us, uint32_t overruns, uint32_t missed);
+
+/**
+ * @brief Send scheduler idle statistics
+ * @param idle_percent Time spent in WFI over the last window, %
+ * @param sleeps WFI entries over the last window
+ * @param wake_max_us Longest notify -> task start, us
+ * @param violations Starts later than the wake-up latency bound
+ */
+void Telemetry_SendIdle(uint8_t idle_percent, uint32_t sleeps, uint32_t wake_max_us,
+                        uint32_t violations);
+
+/**
+ * @brief Send CPU load and main loop timing of the last window
+ * @param cpu_percent Busy time, %
+ * @param loops Main loop iterations
+ * @param loop_min_us Shortest loop period, us
+ * @param loop_avg_us Average loop period, us
+ * @param loop_max_us Longest loop period, us
+ * @param block_us Longest single task run, us
+ * @param block_task Name of that task
+ */
+void Telemetry_SendLoad(uint8_t cpu_percent, uint32_t loops, uint32_t loop_min_us,
+                        uint32_t loop_avg_us, uint32_t loop_max_us, uint32_t block_us,
+                        const char* block_task);
+
+/**
+ * @brief Send RAM usage, bytes
+ * @param ram_total Whole SRAM
+ * @param data Initialized statics
+ * @param bss Zero-initialized statics
+ * @param heap_used Allocated heap
+ * @param heap_arena Heap claimed from sbrk
+ * @param stack_used Main stack high-water mark
+ * @param stack_free Never touched gap between heap and stack
+ */
+void Telemetry_SendMemory(uint32_t ram_total, uint32_t data, uint32_t bss, uint32_t heap_used,
+                          uint32_t heap_arena, uint32_t stack_used, uint32_t stack_free);
+
+/**
+ * @brief Send trace dump framing ("begin" / "end")
+ * @param state "begin" or "end"
+ * @param count Records that follow
+ * @param lost Records overwritten before the dump
+ */
+void Telemetry_SendTrace(const char* state, uint32_t count, uint32_t lost);
+
+/**
+ * @brief Send raw trace records as a hex string
+ * @param data Records
+ * @param size Size, bytes
+ */
+void Telemetry_SendTraceData(const uint8_t* data, uint16_t size);
+
+/**
+ * @brief Send deferred log records as a hex string
+ * @param words Whole records (see dlog.h)
+ * @param count Number of 32-bit words
+ */
+void Telemetry_SendLog(const uint32_t* words, uint8_t count);
+
+/**
+ * @brief Send session recorder dump framing ("begin" / "end")
+ * @param state "begin" or "end"
+ * @param bytes Bytes that follow
+ * @param lost Records overwritten before the dump
+ */
+void Telemetry_SendRecorder(const char* state, uint32_t bytes, uint32_t lost);
+
+/**
+ * @brief Send raw session records as a hex string
+ * @param data Record bytes (see recorder.h)
+ * @param size Size, bytes
+ */
+void Telemetry_SendRecorderData(const uint8_t* data, uint16_t size);
+
+/**
+ * @brief Send active clock profile
+ * @param profile Profile name
+ * @param sysclk Core clock, Hz
+ * @param pclk1 APB1 clock, Hz
+ * @param pclk2 APB2 clock, Hz
+ */
+void Telemetry_SendClock(const char* profile, uint32_t sysclk, uint32_t pclk1, uint32_t pclk2);
+
+/**
+ * @brief Send profiler statistics of one region
+ * @param name Region name
+ * @param count Number of measurements
+ * @param min_cycles Shortest run, cycles
+ * @param avg_cycles Average run, cycles
+ * @param max_cycles Longest run, cycles
+ * @param cycles_per_us Cycles per microsecond (for conversion)
+ */
+void Telemetry_SendProfile(const char* name, uint32_t count, uint32_t min_cycles,
+                           uint32_t avg_cycles, uint32_t max_cycles, uint32_t cycles_per_us);
+
+/**
+ * @brief Send a log2 histogram
+ * @param name Source name (interrupt)
+ * @param kind Histogram kind ("lat", "dur", "jit")
+ * @param count Number of samples
+ * @param max Largest sample, cycles
+ * @param buckets Bucket counts
+ * @param bucket_count Number of buckets
+ */
+void Telemetry_SendHistogram(const char* name, const char* kind, uint32_t count,
+                             uint32_t max, const uint32_t* buckets, uint8_t bucket_count);
+
+/**
+ * @brief Send benchmark result (see bench.h)
+ * @param name Benchmark name
+ * @param iterations Calls measured
+ * @param min_cycles Fastest call, cycles (best batch average)
+ * @param avg_cycles Average call, cycles
+ * @param max_cycles Slowest call, cycles (worst batch average)
+ * @param cycles_per_us Cycles per microsecond (for conversion)
+ */
+void Telemetry_SendBenchmark(const char* name, uint32_t iterations, uint32_t min_cycles,
+                             uint32_t avg_cycles, uint32_t max_cycles, uint32_t cycles_per_us);
+
 /**
  * @brief Send custom JSON string
  * @param json_string Pre-formatted JSON string
@@ -75,4 +264,11 @@ void Telemetry_SendJSON(const char* json_string);
  */
 void Telemetry_SendString(const char* message);
 
+/**
+ * @brief Switch UART output off or on; messages are still formatted, so
+ *        the benchmark measures formatting without wire time
+ * @param muted true = nothing is transmitted
+ */
+void Telemetry_SetMuted(bool muted);
+
 #endif // UART_TELEMETRY_H
@@ -0,0 +1,59 @@
+/**
+ * @file    wheel_sync.h
+ * @brief   Cross-coupled wheel synchronization for straight driving and rotation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Adjusts the per-motor speed setpoints every control tick so the wheels
+ * cover travel in the commanded ratio:
+ *   side error  e_lr = travel_L * |sp_R| - travel_R * |sp_L|  (normalized)
+ *   axle error  e_l  = travel_0 - travel_1,  e_r = travel_2 - travel_3
+ * Left side = Motor 0/1 (front/rear), right side = Motor 2/3.
+ * A wheel that shows no pulses while its axle partner does is treated as
+ * having no encoder and follows its partner's travel.
+ */
+
+#ifndef WHEEL_SYNC_H
+#define WHEEL_SYNC_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Coupling gains, RPM of setpoint correction per encoder count of error */
+#define WHEEL_SYNC_K_SIDE           2.0f
+#define WHEEL_SYNC_K_AXLE           2.0f
+#define WHEEL_SYNC_MAX_CORR_RPM     30.0f   // Correction limit per wheel
+#define WHEEL_SYNC_ABSENT_COUNTS    20      // Partner counts before a silent wheel is "no encoder"
+
+/**
+ * @brief Start synchronized drive (closed loop on all motors)
+ * @param left_rpm Left side setpoint, RPM (negative = reverse)
+ * @param right_rpm Right side setpoint, RPM (negative = reverse)
+ * @note Equal values drive straight, opposite values rotate in place.
+ *       0, 0 stops and disables synchronization.
+ */
+void WheelSync_Drive(float left_rpm, float right_rpm);
+
+/**
+ * @brief Disable synchronization (setpoints are no longer adjusted)
+ */
+void WheelSync_Disable(void);
+
+/**
+ * @brief Check if synchronization is active
+ */
+bool WheelSync_IsActive(void);
+
+/**
+ * @brief Get current side error
+ * @return Left minus right travel, encoder counts (ratio-normalized)
+ */
+int32_t WheelSync_GetSideError(void);
+
+/**
+ * @brief Synchronization step (called from SpeedControl_Tick before the PID)
+ */
+void WheelSync_Tick(void);
+
+#endif // WHEEL_SYNC_H
@@ -0,0 +1,272 @@
+/**
+ * @file    app_tasks.c
+ * @brief   Application bring-up and scheduler tasks (firmware and host build)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "app_tasks.h"
+
+#include "drivers/motor/tb6612fng.h"
+#include "drivers/sensors/encoder.h"
+#include "button_control.h"
+#include "odometry.h"
+#include "speed_control.h"
+#include "autotune.h"
+#include "motor_characterize.h"
+#include "scheduler.h"
+#include "clock_profile.h"
+#include "profiler.h"
+#include "isr_stats.h"
+#include "trace.h"
+#include "dlog.h"
+#include "remote_command.h"
+#include "recorder.h"
+#ifdef USE_UART_TELEMETRY
+#include "uart_telemetry.h"
+#endif
+
+TIM_HandleTypeDef htim1;
+TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim3;
+TIM_HandleTypeDef htim4;
+
+static void Task_Report(void);
+static void Task_Heartbeat(void);
+static void Task_Load(void);
+static void Task_Log(void);
+#ifdef USE_TRACE
+static void Task_Trace(void);
+#endif
+#ifdef USE_RECORDER
+static void Task_Recorder(void);
+#endif
+
+// ============================================================================
+// ИНИЦИАЛИЗАЦИЯ
+// ============================================================================
+
+/**
+ * @brief PWM timer of one motor: 1 MHz counter, 1 kHz PWM, duty 0
+ * Pins are set up by HAL_TIM_PWM_MspInit (main.c).
+ */
+static void App_PwmTimerInit(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint32_t channel)
+{
+    TIM_OC_InitTypeDef sConfigOC = {0};
+
+    htim->Instance = instance;
+    htim->Init.Prescaler = ClockProfile_GetTimerPrescaler(instance); // 1 MHz
+    htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim->Init.Period = 1000 - 1; // 1 MHz / 1000 = 1 kHz PWM
+    htim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim->Init.RepetitionCounter = 0;
+    htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_PWM_Init(htim) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    sConfigOC.OCMode = TIM_OCMODE_PWM1;
+    sConfigOC.Pulse = 0;
+    sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+    if (HAL_TIM_PWM_ConfigChannel(htim, &sConfigOC, channel) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    // Таймери PWM перераховуються при зміні профілю тактування
+    ClockProfile_AddTimer(htim);
+}
+
+void App_Init(void)
+{
+    Dlog_Init();
+
+    #ifdef USE_PROFILER
+    Profiler_Init();
+    #endif
+
+    #ifdef USE_ISR_STATS
+    IsrStats_Init();
+    #endif
+
+    #ifdef USE_TRACE
+    Trace_Init();
+    #endif
+
+    #ifdef USE_RECORDER
+    Recorder_Init();
+    #endif
+
+    // Таймеры PWM моторов
+    App_PwmTimerInit(&htim1, TIM1, TIM_CHANNEL_1);   // Motor 2 - PA8
+    App_PwmTimerInit(&htim2, TIM2, TIM_CHANNEL_1);   // Motor 3 - PA15
+    App_PwmTimerInit(&htim3, TIM3, TIM_CHANNEL_3);   // Motor 0 - PB0
+    App_PwmTimerInit(&htim4, TIM4, TIM_CHANNEL_2);   // Motor 1 - PB7
+
+    // Инициализация драйвера моторов TB6612FNG
+    TB6612FNG_Init(&htim3, &htim4, &htim1, &htim2);
+    TB6612FNG_EnableAll();
+
+    // Инициализация UART телеметрии (отправка данных на ESP32)
+    #ifdef USE_UART_TELEMETRY
+    Telemetry_Init();
+    Telemetry_SendString("STM32 Black Pill Ready!\n");
+    #endif
+
+    // Инициализация кнопок и LED для керування
+    ButtonControl_Init();
+
+    // Инициализация энкодеров (PB5/PB6/PB8/PB9 не пересекаются с моторами)
+    Encoder_Init();
+
+    // Одометрия: поза (0, 0, 0)
+    Odometry_Init();
+
+    // Регулятор скорости: TIM9 500 Гц (энкодеры + PID + одометрия в прерывании)
+    SpeedControl_Init();
+
+    // LED для индикации (PC13)
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    GPIO_InitTypeDef led = {0};
+    led.Pin = GPIO_PIN_13;
+    led.Mode = GPIO_MODE_OUTPUT_PP;
+    HAL_GPIO_Init(GPIOC, &led);
+
+    DLOG(BUTTON_MODE);
+}
+
+void App_StartTasks(void)
+{
+    // Головний цикл: планувальник з періодичними задачами
+    // (регулятор швидкості працює окремо, в перериванні TIM9)
+    // Команди будить RX-переривання; період 20 мс - лише резервне опитування
+    Scheduler_Init();
+    int8_t command_task = Scheduler_AddTask("command", RemoteCommand_Process, 20, 0, 10000);
+    Scheduler_AddTask("input", ButtonControl_Update, BUTTON_POLL_PERIOD_MS, 1, 1000);
+    Scheduler_AddTask("report", Task_Report, 50, 3, 10000);
+    Scheduler_AddTask("heartbeat", Task_Heartbeat, 1000, 7, 10000);
+    Scheduler_AddTask("load", Task_Load, 1000, 507, 10000);
+    Scheduler_AddTask("log", Task_Log, 20, 5, 10000);
+    #ifdef USE_TRACE
+    Scheduler_AddTask("trace", Task_Trace, 10, 9, 10000);
+    #endif
+    #ifdef USE_RECORDER
+    Scheduler_AddTask("recorder", Task_Recorder, 10, 4, 10000);
+    #endif
+    RemoteCommand_Start(command_task);
+    Scheduler_Start();
+}
+
+// ============================================================================
+// ЗАДАЧІ ПЛАНУВАЛЬНИКА
+// ============================================================================
+
+/**
+ * @brief Report results of experiments running in the control tick
+ */
+static void Task_Report(void)
+{
+    #ifdef USE_UART_TELEMETRY
+    // Результат автонастройки
+    Autotune_Result tune;
+    if (Autotune_PollResult(&tune)) {
+        Telemetry_SendAutotune((uint8_t)tune.motor, tune.state == AUTOTUNE_DONE,
+                               tune.ku, tune.tu_s,
+                               tune.gains.kp, tune.gains.ki, tune.gains.kd);
+    }
+
+    // Таблиця калібрування кожного охарактеризованого мотора
+    Motor_ID characterized;
+    if (MotorChar_PollResult(&characterized)) {
+        const MotorChar_Calibration *cal = MotorChar_GetCalibration(characterized);
+        Telemetry_SendCalibration((uint8_t)characterized, cal->valid, cal->deadband,
+                                  cal->slope, cal->tau_ms, cal->max_rpm,
+                                  cal->asymmetry);
+    }
+    #endif
+}
+
+/**
+ * @brief LED PC13 heartbeat and pose snapshot, once per second
+ */
+static void Task_Heartbeat(void)
+{
+    HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_13);
+
+    // Знімок пози раз на секунду (хосту не потрібно опитувати лічильники)
+    RemoteCommand_SendPose();
+}
+
+/**
+ * @brief Publish CPU load and main loop timing of the last second
+ */
+static void Task_Load(void)
+{
+    #ifdef USE_UART_TELEMETRY
+    Scheduler_LoadStats load;
+    Scheduler_GetLoadStats(&load);
+    Telemetry_SendLoad(load.cpu_percent, load.loops, load.loop_min_us, load.loop_avg_us,
+                       load.loop_max_us, load.longest_us, load.longest_task);
+    #endif
+}
+
+/**
+ * @brief Send pending deferred log records (decoded by tools/dlog_decode.py)
+ */
+static void Task_Log(void)
+{
+    #ifdef USE_UART_TELEMETRY
+    uint32_t words[TELEMETRY_LOG_WORDS];
+    uint8_t n = Dlog_Read(words, TELEMETRY_LOG_WORDS);
+    if (n > 0)
+        Telemetry_SendLog(words, n);
+    #else
+    // Нікуди відправляти - просто звільнити буфер
+    uint32_t words[DLOG_RECORD_WORDS(DLOG_MAX_ARGS)];
+    while (Dlog_Read(words, DLOG_RECORD_WORDS(DLOG_MAX_ARGS)) > 0) {}
+    #endif
+}
+
+#ifdef USE_TRACE
+/**
+ * @brief Stream a trace dump started by "C:Y", a few records per run
+ */
+static void Task_Trace(void)
+{
+    if (!Trace_IsDumping()) return;
+
+    #ifdef USE_UART_TELEMETRY
+    Trace_Entry records[TELEMETRY_TRACE_RECORDS];
+    uint8_t n = Trace_ReadDump(records, TELEMETRY_TRACE_RECORDS);
+    if (n > 0)
+        Telemetry_SendTraceData((const uint8_t*)records, n * sizeof(Trace_Entry));
+    else
+        Telemetry_SendTrace("end", 0, 0);
+    #else
+    Trace_Clear();
+    #endif
+}
+#endif
+
+#ifdef USE_RECORDER
+/**
+ * @brief Stream a session dump started by "C:G", one line per run
+ */
+static void Task_Recorder(void)
+{
+    if (!Recorder_IsDumping()) return;
+
+    #ifdef USE_UART_TELEMETRY
+    uint8_t data[TELEMETRY_RECORDER_BYTES];
+    uint16_t n = Recorder_ReadDump(data, TELEMETRY_RECORDER_BYTES);
+    if (n > 0)
+        Telemetry_SendRecorderData(data, n);
+    else
+        Telemetry_SendRecorder("end", 0, 0);
+    #else
+    Recorder_Clear();
+    #endif
+}
+#endif
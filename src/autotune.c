@@ -0,0 +1,234 @@
+/**
+ * @file    autotune.c
+ * @brief   Relay-feedback PID auto-tuning implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * One relay period = output switches high -> low -> high. The first
+ * AUTOTUNE_SKIP_CYCLES periods are transient, the next
+ * AUTOTUNE_MEASURE_CYCLES are averaged for amplitude and period.
+ */
+
+#include "autotune.h"
+#include "drivers/sensors/encoder.h"
+#include "motor_characterize.h"
+#include <math.h>
+
+#define AUTOTUNE_MS_TO_TICKS(ms)    ((uint32_t)(ms) * SPEED_CONTROL_RATE_HZ / 1000)
+
+/* Experiment context (shared between main loop and control tick) */
+static struct {
+    volatile Autotune_State state;
+    Motor_ID motor;
+    Autotune_Rule rule;
+    Motor_Direction direction;
+    float setpoint;         // |setpoint|, RPM
+    float bias;             // Duty %, relay centre
+    float relay;            // Relay amplitude d, duty %
+    bool relay_high;        // Current relay output
+    uint32_t ticks;         // Ticks since start
+    uint32_t cycle_start;   // Tick of the last low -> high switch (0 = none yet)
+    uint8_t cycles;         // Complete relay periods seen
+    uint8_t measured;       // Periods included in the averages
+    float rpm_max;          // Extremes of the current period
+    float rpm_min;
+    float sum_amplitude;
+    uint32_t sum_period;    // Ticks
+} at;
+
+static Autotune_Result result;
+static volatile bool result_ready = false;
+
+/**
+ * @brief Drive the motor under test at the given duty
+ */
+static void Autotune_Drive(float duty)
+{
+    TB6612FNG_Drive(at.motor, at.direction, (uint8_t)(duty + 0.5f));
+}
+
+/**
+ * @brief End the experiment, publish result
+ */
+static void Autotune_Finish(Autotune_State state)
+{
+    TB6612FNG_Stop(at.motor);
+    result.motor = at.motor;
+    result.state = state;
+    at.state = state;
+    result_ready = true;
+}
+
+/**
+ * @brief Compute Ku / Tu and tuned gains from the averaged limit cycle
+ */
+static void Autotune_Compute(void)
+{
+    float amplitude = at.sum_amplitude / at.measured;
+    float tu = (float)at.sum_period / at.measured / SPEED_CONTROL_RATE_HZ;
+    float h = AUTOTUNE_HYSTERESIS_RPM;
+
+    result.amplitude_rpm = amplitude;
+    result.tu_s = tu;
+
+    if (amplitude <= h || tu <= 0.0f) {
+        result.ku = 0.0f;
+        Autotune_Finish(AUTOTUNE_FAILED);
+        return;
+    }
+
+    /* Describing function of a relay with hysteresis */
+    float ku = 4.0f * at.relay / (3.14159265f * sqrtf(amplitude * amplitude - h * h));
+    result.ku = ku;
+
+    /* Ziegler-Nichols; feed-forward and deadband stay as they were */
+    SpeedControl_Gains gains;
+    SpeedControl_GetGains(at.motor, &gains);
+    if (at.rule == AUTOTUNE_RULE_PID) {
+        gains.kp = 0.60f * ku;
+        gains.ki = 1.20f * ku / tu;
+        gains.kd = 0.075f * ku * tu;
+    } else {
+        gains.kp = 0.45f * ku;
+        gains.ki = 0.54f * ku / tu;
+        gains.kd = 0.0f;
+    }
+    SpeedControl_SetGains(at.motor, &gains);
+    result.gains = gains;
+
+    Autotune_Finish(AUTOTUNE_DONE);
+}
+
+/**
+ * @brief Start relay experiment
+ */
+bool Autotune_Start(Motor_ID motor, float setpoint_rpm, uint8_t relay_amplitude,
+                    Autotune_Rule rule)
+{
+    if (motor >= MOTOR_COUNT || setpoint_rpm == 0.0f || Autotune_IsRunning() ||
+        MotorChar_IsRunning()) {
+        return false;
+    }
+    if (relay_amplitude == 0) relay_amplitude = AUTOTUNE_RELAY_DEFAULT;
+    if (relay_amplitude >= 50) return false;
+
+    SpeedControl_Disable(motor);
+
+    /* Relay centre: current feed-forward estimate, kept inside [d, 100 - d] */
+    SpeedControl_Gains gains;
+    SpeedControl_GetGains(motor, &gains);
+    float target = fabsf(setpoint_rpm);
+    uint8_t dir = (setpoint_rpm > 0.0f) ? SPEED_CONTROL_FWD : SPEED_CONTROL_REV;
+    float bias = gains.kff[dir] * target + gains.deadband[dir];
+    if (bias < relay_amplitude) bias = relay_amplitude;
+    if (bias > SPEED_CONTROL_OUT_MAX - relay_amplitude) bias = SPEED_CONTROL_OUT_MAX - relay_amplitude;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    at.motor = motor;
+    at.rule = rule;
+    at.direction = (setpoint_rpm > 0.0f) ? MOTOR_FORWARD : MOTOR_REVERSE;
+    at.setpoint = target;
+    at.bias = bias;
+    at.relay = relay_amplitude;
+    at.relay_high = false;
+    at.ticks = 0;
+    at.cycle_start = 0;
+    at.cycles = 0;
+    at.measured = 0;
+    at.sum_amplitude = 0.0f;
+    at.sum_period = 0;
+    result_ready = false;
+    at.state = AUTOTUNE_SETTLING;
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+void Autotune_Abort(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (Autotune_IsRunning()) {
+        TB6612FNG_Stop(at.motor);
+        at.state = AUTOTUNE_IDLE;
+    }
+    __set_PRIMASK(primask);
+}
+
+bool Autotune_IsRunning(void)
+{
+    return at.state == AUTOTUNE_SETTLING || at.state == AUTOTUNE_RELAY;
+}
+
+bool Autotune_IsTesting(Motor_ID motor)
+{
+    return Autotune_IsRunning() && at.motor == motor;
+}
+
+bool Autotune_PollResult(Autotune_Result *out)
+{
+    if (!result_ready) return false;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = result;
+    result_ready = false;
+    __set_PRIMASK(primask);
+    return true;
+}
+
+/**
+ * @brief Experiment step at the control rate
+ */
+void Autotune_Tick(void)
+{
+    if (!Autotune_IsRunning()) return;
+
+    at.ticks++;
+    if (at.ticks > AUTOTUNE_MS_TO_TICKS(AUTOTUNE_TIMEOUT_MS)) {
+        Autotune_Finish(AUTOTUNE_FAILED);
+        return;
+    }
+
+    float rpm = Encoder_GetRPM((Encoder_ID)at.motor);
+
+    if (at.state == AUTOTUNE_SETTLING) {
+        Autotune_Drive(at.bias);
+        if (at.ticks >= AUTOTUNE_MS_TO_TICKS(AUTOTUNE_SETTLE_MS)) {
+            at.state = AUTOTUNE_RELAY;
+            at.relay_high = (rpm < at.setpoint);
+            at.rpm_max = rpm;
+            at.rpm_min = rpm;
+        }
+        return;
+    }
+
+    if (rpm > at.rpm_max) at.rpm_max = rpm;
+    if (rpm < at.rpm_min) at.rpm_min = rpm;
+
+    if (at.relay_high && rpm > at.setpoint + AUTOTUNE_HYSTERESIS_RPM) {
+        at.relay_high = false;
+    } else if (!at.relay_high && rpm < at.setpoint - AUTOTUNE_HYSTERESIS_RPM) {
+        /* Low -> high switch closes one relay period */
+        at.relay_high = true;
+        if (at.cycle_start != 0) {
+            at.cycles++;
+            if (at.cycles > AUTOTUNE_SKIP_CYCLES) {
+                at.sum_amplitude += (at.rpm_max - at.rpm_min) * 0.5f;
+                at.sum_period += at.ticks - at.cycle_start;
+                at.measured++;
+            }
+        }
+        at.cycle_start = at.ticks;
+        at.rpm_max = rpm;
+        at.rpm_min = rpm;
+
+        if (at.measured >= AUTOTUNE_MEASURE_CYCLES) {
+            Autotune_Compute();
+            return;
+        }
+    }
+
+    Autotune_Drive(at.relay_high ? at.bias + at.relay : at.bias - at.relay);
+}
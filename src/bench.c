@@ -0,0 +1,287 @@
+/**
+ * @file    bench.c
+ * @brief   Micro-benchmark suite implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "bench.h"
+
+#ifdef USE_BENCH
+
+#include "main.h"
+#include "profiler.h"
+#include "remote_command.h"
+#include "speed_control.h"
+#include "odometry.h"
+#include "drivers/motor/tb6612fng.h"
+#include "drivers/sensors/encoder.h"
+#include "drivers/sensors/velocity_filter.h"
+#ifdef USE_UART_TELEMETRY
+#include "uart_telemetry.h"
+#endif
+
+/* Kernel under test; i = iteration number, to vary the inputs */
+typedef void (*Bench_Fn)(uint32_t i);
+
+static VFilter bench_filter;
+
+/* Noisy RPM around 180 (slot-edge jitter), Q16.16 */
+static q16_t Bench_Sample(uint32_t i)
+{
+    uint32_t noise = (i * 2654435761u) >> 24;   // 0..255, pseudo-random
+    return Q16_FROM_INT(180) + (q16_t)(noise - 128) * 2048;
+}
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+#ifdef USE_UART_TELEMETRY
+/* Payloads */
+static const float bench_pair[2] = {11.2f, 12.0f};
+static const uint16_t bench_tau[2] = {84, 90};
+static const uint32_t bench_hist[9] = {0, 0, 0, 0, 0, 0, 0, 4990, 10};
+static const uint32_t bench_words[TELEMETRY_LOG_WORDS] = {
+    0x00020004u, 0x12345678u, 0x000001F4u, 0x00000046u, 0x00010007u,
+    0x12346000u, 0x00000003u, 0x00020004u, 0x12347000u, 0x000001F4u
+};
+
+static void Bench_TelemetryButton(uint32_t i)   { Telemetry_SendButton(i & 3, i & 1); }
+static void Bench_TelemetryMotor(uint32_t i)    { Telemetry_SendMotor(i & 3, i % 3, 70); }
+static void Bench_TelemetryRPM(uint32_t i)      { Telemetry_SendRPM(i & 3, 180.5f + i); }
+static void Bench_TelemetryPose(uint32_t i)     { Telemetry_SendPose(1250 + i, -40, 1250); }
+static void Bench_TelemetryIdle(uint32_t i)     { Telemetry_SendIdle(85, 1520 + i, 212, 0); }
+static void Bench_TelemetryLog(uint32_t i)      { (void)i; Telemetry_SendLog(bench_words, TELEMETRY_LOG_WORDS); }
+static void Bench_TelemetryJSON(uint32_t i)     { (void)i; Telemetry_SendJSON("{\"status\":\"ok\"}"); }
+static void Bench_TelemetryString(uint32_t i)   { (void)i; Telemetry_SendString("STM32 Black Pill Ready!\n"); }
+
+static void Bench_TelemetryTraceData(uint32_t i)
+{
+    (void)i;
+    Telemetry_SendTraceData((const uint8_t *)bench_words, TELEMETRY_TRACE_RECORDS * 12);
+}
+
+static void Bench_TelemetryAllMotors(uint32_t i)
+{
+    uint8_t states[4] = {1, 0, (uint8_t)(i & 1), 1};
+    uint8_t speeds[4] = {80, 0, 50, (uint8_t)(i & 0x7F)};
+    Telemetry_SendAllMotors(states, speeds);
+}
+
+static void Bench_TelemetryEncoder(uint32_t i)
+{
+    Telemetry_SendEncoder(i & 3, Q16_TO_FLOAT(Bench_Sample(i)), i);
+}
+
+static void Bench_TelemetrySpeed(uint32_t i)
+{
+    Telemetry_SendSpeed(i & 3, 120.0f, Q16_TO_FLOAT(Bench_Sample(i)), 31.2f);
+}
+
+static void Bench_TelemetryAutotune(uint32_t i)
+{
+    Telemetry_SendAutotune(i & 3, 1, 0.412f, 0.184f, 0.185f, 1.209f, 0.0f);
+}
+
+static void Bench_TelemetryCalibration(uint32_t i)
+{
+    Telemetry_SendCalibration(i & 3, 1, bench_pair, bench_pair, bench_tau, bench_pair, 4.7f);
+}
+
+static void Bench_TelemetryTask(uint32_t i)
+{
+    Telemetry_SendTask(i & 7, "heartbeat", 1000 + i, 12, 40, 0, 0);
+}
+
+static void Bench_TelemetryLoad(uint32_t i)
+{
+    Telemetry_SendLoad(12, 1450 + i, 8, 689, 1012, 4310, "command");
+}
+
+static void Bench_TelemetryMemory(uint32_t i)
+{
+    Telemetry_SendMemory(131072, 120, 4816, 1428 + i, 2048, 1864, 121512);
+}
+
+static void Bench_TelemetryTrace(uint32_t i)
+{
+    Telemetry_SendTrace("begin", 256, 1840 + i);
+}
+
+static void Bench_TelemetryClock(uint32_t i)
+{
+    Telemetry_SendClock("balanced", 96000000u, 48000000u, 96000000u + i);
+}
+
+static void Bench_TelemetryProfile(uint32_t i)
+{
+    Telemetry_SendProfile("encoder_update", 5000 + i, 410, 455, 1210, 96);
+}
+
+static void Bench_TelemetryHistogram(uint32_t i)
+{
+    Telemetry_SendHistogram("control", "lat", 5000 + i, 288, bench_hist, 9);
+}
+#endif // USE_UART_TELEMETRY
+
+static void Bench_CommandStop(uint32_t i)       { (void)i; RemoteCommand_Execute("C:S"); }
+static void Bench_CommandForward(uint32_t i)    { (void)i; RemoteCommand_Execute("C:F:0"); }
+static void Bench_CommandMotor(uint32_t i)      { (void)i; RemoteCommand_Execute("C:M:1:F:0"); }
+static void Bench_CommandVelocity(uint32_t i)   { (void)i; RemoteCommand_Execute("C:V:A:0"); }
+static void Bench_CommandPose(uint32_t i)       { (void)i; RemoteCommand_Execute("C:P"); }
+static void Bench_CommandEncoder(uint32_t i)    { (void)i; RemoteCommand_Execute("C:E"); }
+static void Bench_CommandUnknown(uint32_t i)    { (void)i; RemoteCommand_Execute("C:~:12"); }
+static void Bench_CommandReject(uint32_t i)     { (void)i; RemoteCommand_Execute("hello"); }
+
+static void Bench_EncoderUpdate(uint32_t i)     { (void)i; Encoder_Update(); }
+static void Bench_ControlTick(uint32_t i)       { (void)i; SpeedControl_Tick(); }
+static void Bench_OdometryUpdate(uint32_t i)    { (void)i; Odometry_Update(); }
+
+static void Bench_Filter(uint32_t i)
+{
+    VFilter_Update(&bench_filter, Bench_Sample(i), 2000);
+}
+
+static void Bench_DriverDrive(uint32_t i)
+{
+    TB6612FNG_Drive((Motor_ID)(i & 3), (Motor_Direction)(i % 3), 0);
+}
+
+static void Bench_DriverSetSpeed(uint32_t i)
+{
+    TB6612FNG_SetSpeed((Motor_ID)(i & 3), 0);
+}
+
+static void Bench_DriverStopAll(uint32_t i)     { (void)i; TB6612FNG_StopAll(); }
+
+// ============================================================================
+// Benchmark table: X(name, kernel, filter type for the vfilter_* kernels)
+// ============================================================================
+
+#ifdef USE_UART_TELEMETRY
+#define BENCH_TELEMETRY(X)                                                  \
+    X("telemetry_button",       Bench_TelemetryButton,      VFILTER_NONE)  \
+    X("telemetry_motor",        Bench_TelemetryMotor,       VFILTER_NONE)  \
+    X("telemetry_all_motors",   Bench_TelemetryAllMotors,   VFILTER_NONE)  \
+    X("telemetry_rpm",          Bench_TelemetryRPM,         VFILTER_NONE)  \
+    X("telemetry_encoder",      Bench_TelemetryEncoder,     VFILTER_NONE)  \
+    X("telemetry_pose",         Bench_TelemetryPose,        VFILTER_NONE)  \
+    X("telemetry_speed",        Bench_TelemetrySpeed,       VFILTER_NONE)  \
+    X("telemetry_autotune",     Bench_TelemetryAutotune,    VFILTER_NONE)  \
+    X("telemetry_calibration",  Bench_TelemetryCalibration, VFILTER_NONE)  \
+    X("telemetry_task",         Bench_TelemetryTask,        VFILTER_NONE)  \
+    X("telemetry_idle",         Bench_TelemetryIdle,        VFILTER_NONE)  \
+    X("telemetry_load",         Bench_TelemetryLoad,        VFILTER_NONE)  \
+    X("telemetry_memory",       Bench_TelemetryMemory,      VFILTER_NONE)  \
+    X("telemetry_trace",        Bench_TelemetryTrace,       VFILTER_NONE)  \
+    X("telemetry_trace_data",   Bench_TelemetryTraceData,   VFILTER_NONE)  \
+    X("telemetry_log",          Bench_TelemetryLog,         VFILTER_NONE)  \
+    X("telemetry_clock",        Bench_TelemetryClock,       VFILTER_NONE)  \
+    X("telemetry_profile",      Bench_TelemetryProfile,     VFILTER_NONE)  \
+    X("telemetry_histogram",    Bench_TelemetryHistogram,   VFILTER_NONE)  \
+    X("telemetry_json",         Bench_TelemetryJSON,        VFILTER_NONE)  \
+    X("telemetry_string",       Bench_TelemetryString,      VFILTER_NONE)
+#else
+#define BENCH_TELEMETRY(X)
+#endif
+
+#define BENCH_LIST(X)                                                       \
+    BENCH_TELEMETRY(X)                                                      \
+    X("command_stop",           Bench_CommandStop,          VFILTER_NONE)  \
+    X("command_forward",        Bench_CommandForward,       VFILTER_NONE)  \
+    X("command_motor",          Bench_CommandMotor,         VFILTER_NONE)  \
+    X("command_velocity",       Bench_CommandVelocity,      VFILTER_NONE)  \
+    X("command_pose",           Bench_CommandPose,          VFILTER_NONE)  \
+    X("command_encoder",        Bench_CommandEncoder,       VFILTER_NONE)  \
+    X("command_unknown",        Bench_CommandUnknown,       VFILTER_NONE)  \
+    X("command_reject",         Bench_CommandReject,        VFILTER_NONE)  \
+    X("encoder_update",         Bench_EncoderUpdate,        VFILTER_NONE)  \
+    X("vfilter_none",           Bench_Filter,               VFILTER_NONE)  \
+    X("vfilter_iir",            Bench_Filter,               VFILTER_IIR)   \
+    X("vfilter_median",         Bench_Filter,               VFILTER_MEDIAN) \
+    X("vfilter_alpha_beta",     Bench_Filter,               VFILTER_ALPHA_BETA) \
+    X("odometry_update",        Bench_OdometryUpdate,       VFILTER_NONE)  \
+    X("control_tick",           Bench_ControlTick,          VFILTER_NONE)  \
+    X("driver_drive",           Bench_DriverDrive,          VFILTER_NONE)  \
+    X("driver_set_speed",       Bench_DriverSetSpeed,       VFILTER_NONE)  \
+    X("driver_stop_all",        Bench_DriverStopAll,        VFILTER_NONE)
+
+typedef struct {
+    const char *name;
+    Bench_Fn fn;
+    VFilter_Type filter;
+} Bench_Entry;
+
+static const Bench_Entry bench_table[] = {
+#define BENCH_ENTRY_(name, fn, filter) {name, fn, filter},
+    BENCH_LIST(BENCH_ENTRY_)
+#undef BENCH_ENTRY_
+};
+
+#define BENCH_COUNT     (sizeof(bench_table) / sizeof(bench_table[0]))
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+/**
+ * @brief Leave the motors stopped and the speed loop off
+ */
+static void Bench_Quiesce(void)
+{
+    SpeedControl_DisableAll();
+    TB6612FNG_StopAll();
+}
+
+uint8_t Bench_Count(void)
+{
+    return (uint8_t)BENCH_COUNT;
+}
+
+bool Bench_Run(uint8_t index, Bench_Result *result)
+{
+    if (index >= BENCH_COUNT) return false;
+
+    const Bench_Entry *b = &bench_table[index];
+    uint64_t total = 0;
+    uint32_t min = UINT32_MAX, max = 0;
+    uint32_t i = 0;
+
+    VFilter_Init(&bench_filter, b->filter);
+    Bench_Quiesce();
+    #ifdef USE_UART_TELEMETRY
+    Telemetry_SetMuted(true);
+    #endif
+
+    /* Warm-up batch: flash cache and first-call paths */
+    for (uint32_t k = 0; k < BENCH_BATCH; k++) b->fn(k);
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint32_t start = Profiler_Now();
+        for (uint32_t k = 0; k < BENCH_BATCH; k++) b->fn(i++);
+        uint32_t cycles = Profiler_Now() - start;
+        __set_PRIMASK(primask);
+
+        total += cycles;
+        cycles /= BENCH_BATCH;
+        if (cycles < min) min = cycles;
+        if (cycles > max) max = cycles;
+    }
+
+    Bench_Quiesce();
+    #ifdef USE_UART_TELEMETRY
+    Telemetry_SetMuted(false);
+    #endif
+
+    result->name = b->name;
+    result->iterations = i;
+    result->min = min;
+    result->avg = (uint32_t)(total / i);
+    result->max = max;
+    return true;
+}
+
+#endif // USE_BENCH
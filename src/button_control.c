@@ -6,13 +6,30 @@
  *
  * Logic: Hold button → motor runs + LED on
  *        Release button → motor stops + LED off
+ *        Long press → full speed, chord (2+ buttons) → brake all
  */
 
 #include "button_control.h"
-#include <stdio.h>
-
-/* Previous button states for edge detection */
-static uint8_t button_prev_state[BUTTON_COUNT] = {0};
+#include "speed_control.h"
+#include "profiler.h"
+#include "isr_stats.h"
+#include "trace.h"
+#include "dlog.h"
+#include "timebase.h"
+
+/* Debounced state, bit n = BTN_n (all buttons processed in parallel) */
+static volatile uint8_t button_held = 0;        // Debounced pressed
+static uint8_t button_long = 0;                 // Long press already reported
+static volatile uint8_t vc_count0 = 0;          // Vertical counter, bit 0
+static volatile uint8_t vc_count1 = 0;          // Vertical counter, bit 1
+static volatile uint32_t button_change_time[BUTTON_COUNT] = {0};   // Last accepted change, us
+static volatile uint32_t button_press_time[BUTTON_COUNT] = {0};    // Timebase, us
+
+/* Event queue: producers = EXTI handlers and ButtonControl_Update, consumer = Update */
+static Button_Event event_queue[BUTTON_EVENT_QUEUE_SIZE];
+static volatile uint8_t event_head = 0;
+static volatile uint8_t event_tail = 0;
+static volatile uint32_t event_dropped = 0;
 
 /**
  * @brief Initialize GPIO for buttons (input with pull-up) and LEDs (output)
@@ -28,25 +45,25 @@ void ButtonControl_Init(void)
 
     /* Configure Button 0 (PB3) */
     GPIO_InitStruct.Pin = BTN_0_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
     GPIO_InitStruct.Pull = GPIO_PULLUP;  // Internal pull-up resistor
     HAL_GPIO_Init(BTN_0_PORT, &GPIO_InitStruct);
 
     /* Configure Button 1 (PB4) */
     GPIO_InitStruct.Pin = BTN_1_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
     GPIO_InitStruct.Pull = GPIO_PULLUP;
     HAL_GPIO_Init(BTN_1_PORT, &GPIO_InitStruct);
 
     /* Configure Button 2 (PC14) */
     GPIO_InitStruct.Pin = BTN_2_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
     GPIO_InitStruct.Pull = GPIO_PULLUP;
     HAL_GPIO_Init(BTN_2_PORT, &GPIO_InitStruct);
 
     /* Configure Button 3 (PC15) */
     GPIO_InitStruct.Pin = BTN_3_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
     GPIO_InitStruct.Pull = GPIO_PULLUP;
     HAL_GPIO_Init(BTN_3_PORT, &GPIO_InitStruct);
 
@@ -63,46 +80,45 @@ void ButtonControl_Init(void)
     HAL_GPIO_WritePin(LED_2_PORT, LED_2_PIN, GPIO_PIN_RESET);
     HAL_GPIO_WritePin(LED_3_PORT, LED_3_PIN, GPIO_PIN_RESET);
 
-    printf("\n=== Button Control Initialized ===\n");
-    printf("BTN_0 (PB3)  → Motor 0 + LED_0 (PA5)\n");
-    printf("BTN_1 (PB4)  → Motor 1 + LED_1 (PA6)\n");
-    printf("BTN_2 (PC14) → Motor 2 + LED_2 (PA7)\n");
-    printf("BTN_3 (PC15) → Motor 3 + LED_3 (PA11)\n");
-    printf("Hold button to run motor at %d%% speed\n\n", MOTOR_DEFAULT_SPEED);
+    /* Button edge interrupts */
+    HAL_NVIC_SetPriority(EXTI3_IRQn, BUTTON_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+    HAL_NVIC_SetPriority(EXTI4_IRQn, BUTTON_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(EXTI4_IRQn);
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, BUTTON_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+
+    DLOG(BUTTON_INIT, MOTOR_DEFAULT_SPEED);
 }
 
 /**
- * @brief Check if button is pressed
+ * @brief Sample all buttons: one IDR read per port, no per-pin HAL calls
  * @note Buttons are active LOW (0 = pressed, 1 = released)
  */
-uint8_t ButtonControl_IsPressed(Button_ID button_id)
+uint8_t ButtonControl_Sample(void)
 {
-    GPIO_TypeDef* port;
-    uint16_t pin;
+    uint32_t idr_a = BTN_SAMPLE_PORT_A->IDR;
+    uint32_t idr_b = BTN_SAMPLE_PORT_B->IDR;
 
-    switch (button_id) {
-        case BUTTON_0:
-            port = BTN_0_PORT;
-            pin = BTN_0_PIN;
-            break;
-        case BUTTON_1:
-            port = BTN_1_PORT;
-            pin = BTN_1_PIN;
-            break;
-        case BUTTON_2:
-            port = BTN_2_PORT;
-            pin = BTN_2_PIN;
-            break;
-        case BUTTON_3:
-            port = BTN_3_PORT;
-            pin = BTN_3_PIN;
-            break;
-        default:
-            return 0;
-    }
+    return BTN_PRESSED_BIT(idr_a, BTN_0_PIN, 0) | BTN_PRESSED_BIT(idr_a, BTN_1_PIN, 1) |
+           BTN_PRESSED_BIT(idr_b, BTN_2_PIN, 2) | BTN_PRESSED_BIT(idr_b, BTN_3_PIN, 3);
+}
 
-    /* Button is pressed when pin is LOW (pull-up resistor) */
-    return (HAL_GPIO_ReadPin(port, pin) == GPIO_PIN_RESET) ? 1 : 0;
+/**
+ * @brief Check if button is pressed (raw level)
+ */
+uint8_t ButtonControl_IsPressed(Button_ID button_id)
+{
+    if (button_id >= BUTTON_COUNT) return 0;
+    return (ButtonControl_Sample() >> button_id) & 1U;
+}
+
+/**
+ * @brief Get debounced button states
+ */
+uint8_t ButtonControl_GetState(void)
+{
+    return button_held;
 }
 
 /**
@@ -228,58 +244,235 @@ static void SendAllMotors(uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3, uint8_
 }
 
 /**
- * @brief Main control loop - D-pad style robot control
- * Call this function in main() while(1) loop
+ * @brief Append event to the queue (caller masks interrupts or runs in ISR)
  */
-void ButtonControl_Update(void)
+static void Button_PushEvent(Button_EventType type, uint8_t button, uint32_t now)
+{
+    TRACE(BUTTON, type, button | (button_held << 8));
+
+    uint8_t next = (event_head + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+    if (next == event_tail) {
+        event_dropped++;
+        return;
+    }
+    event_queue[event_head].type = type;
+    event_queue[event_head].button = button;
+    event_queue[event_head].mask = button_held;
+    event_queue[event_head].time_us = now;
+    event_head = next;
+}
+
+/**
+ * @brief Turn accepted state changes into events (caller masks interrupts)
+ * @param changed Buttons whose debounced state just changed
+ */
+static void Button_Accept(uint8_t changed, uint32_t now)
 {
     for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
-        uint8_t is_pressed = ButtonControl_IsPressed((Button_ID)i);
-
-        if (is_pressed && !button_prev_state[i]) {
-            /* Button pressed - execute movement */
-            ButtonControl_LED_On(i);
-            #ifdef USE_UART_TELEMETRY
-            Telemetry_SendButton(i, 1);
-            #endif
-
-            switch (i) {
-                case 0: /* Forward */
-                    printf("BTN_0 → FORWARD %d%%\n", MOTOR_DEFAULT_SPEED);
-                    TB6612FNG_MoveForward(MOTOR_DEFAULT_SPEED);
-                    SendAllMotors(MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_DEFAULT_SPEED);
-                    break;
-                case 1: /* Left (rotate in place) */
-                    printf("BTN_1 → ROTATE LEFT %d%%\n", MOTOR_DEFAULT_SPEED);
-                    TB6612FNG_RotateLeft(MOTOR_DEFAULT_SPEED);
-                    SendAllMotors(MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_DEFAULT_SPEED);
-                    break;
-                case 2: /* Right (rotate in place) */
-                    printf("BTN_2 → ROTATE RIGHT %d%%\n", MOTOR_DEFAULT_SPEED);
-                    TB6612FNG_RotateRight(MOTOR_DEFAULT_SPEED);
-                    SendAllMotors(MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_DEFAULT_SPEED);
-                    break;
-                case 3: /* Backward */
-                    printf("BTN_3 → BACKWARD %d%%\n", MOTOR_DEFAULT_SPEED);
-                    TB6612FNG_MoveBackward(MOTOR_DEFAULT_SPEED);
-                    SendAllMotors(MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_DEFAULT_SPEED);
+        uint8_t bit = (uint8_t)(1U << i);
+        if (!(changed & bit)) continue;
+
+        button_change_time[i] = now;
+
+        if (button_held & bit) {
+            button_press_time[i] = now;
+            Button_PushEvent(BUTTON_EVENT_PRESS, i, now);
+
+            /* Chord: another button went down within the window */
+            for (uint8_t j = 0; j < BUTTON_COUNT; j++) {
+                if (j != i && (button_held & (1U << j)) &&
+                    now - button_press_time[j] <= BUTTON_CHORD_WINDOW_MS * 1000U) {
+                    Button_PushEvent(BUTTON_EVENT_CHORD, i, now);
                     break;
+                }
             }
+        } else {
+            button_long &= (uint8_t)~bit;
+            Button_PushEvent(BUTTON_EVENT_RELEASE, i, now);
+        }
+    }
+}
+
+/**
+ * @brief Press edge (EXTI): accept new presses at once for low latency
+ * A button must have been released for BUTTON_DEBOUNCE_MS, so release
+ * bounce cannot re-trigger it; everything else goes through the counters.
+ */
+static void Button_OnEdge(void)
+{
+    uint32_t now = Timebase_NowUs();
+    uint8_t pressed = ButtonControl_Sample() & (uint8_t)~button_held;
+
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        if (now - button_change_time[i] < BUTTON_DEBOUNCE_MS * 1000U) {
+            pressed &= (uint8_t)~(1U << i);
         }
-        else if (!is_pressed && button_prev_state[i]) {
-            /* Button released - stop all motors */
-            printf("BTN_%d released → STOP ALL\n", i);
-            TB6612FNG_StopAll();
-            ButtonControl_LED_Off(i);
-
-            #ifdef USE_UART_TELEMETRY
-            Telemetry_SendButton(i, 0);
-            SendAllMotors(MOTOR_STOP, MOTOR_STOP, MOTOR_STOP, MOTOR_STOP, 0);
-            #endif
+    }
+    if (pressed == 0) return;
+
+    button_held |= pressed;
+    vc_count0 &= (uint8_t)~pressed;
+    vc_count1 &= (uint8_t)~pressed;
+    Button_Accept(pressed, now);
+}
+
+/**
+ * @brief Take the next event from the queue
+ */
+bool ButtonControl_GetEvent(Button_Event *event)
+{
+    if (event_tail == event_head) return false;
+
+    *event = event_queue[event_tail];
+    event_tail = (event_tail + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+    return true;
+}
+
+uint32_t ButtonControl_GetDroppedEvents(void)
+{
+    return event_dropped;
+}
+
+/**
+ * @brief Execute the D-pad action of a button
+ */
+static void Button_Drive(uint8_t button, uint8_t speed)
+{
+    switch (button) {
+        case 0: /* Forward */
+            DLOG(BUTTON_FORWARD, speed);
+            TB6612FNG_MoveForward(speed);
+            SendAllMotors(MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_FORWARD, speed);
+            break;
+        case 1: /* Left (rotate in place) */
+            DLOG(BUTTON_LEFT, speed);
+            TB6612FNG_RotateLeft(speed);
+            SendAllMotors(MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_FORWARD, MOTOR_FORWARD, speed);
+            break;
+        case 2: /* Right (rotate in place) */
+            DLOG(BUTTON_RIGHT, speed);
+            TB6612FNG_RotateRight(speed);
+            SendAllMotors(MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_REVERSE, MOTOR_REVERSE, speed);
+            break;
+        case 3: /* Backward */
+            DLOG(BUTTON_BACKWARD, speed);
+            TB6612FNG_MoveBackward(speed);
+            SendAllMotors(MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_REVERSE, MOTOR_REVERSE, speed);
+            break;
+    }
+}
+
+/**
+ * @brief Input task - D-pad style robot control
+ * Called every BUTTON_POLL_PERIOD_MS by the scheduler (non-blocking)
+ */
+void ButtonControl_Update(void)
+{
+    PROFILE_BEGIN(BUTTON_UPDATE);
+    uint32_t now = Timebase_NowUs();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    /* Vertical counter debounce: a bit toggles after BUTTON_DEBOUNCE_SAMPLES
+     * consecutive samples that differ from the debounced state */
+    uint8_t delta = ButtonControl_Sample() ^ button_held;
+    vc_count1 = (vc_count1 ^ vc_count0) & delta;
+    vc_count0 = (uint8_t)~vc_count0 & delta;
+    uint8_t toggle = delta & (uint8_t)~(vc_count0 | vc_count1);
+    button_held ^= toggle;
+    if (toggle) Button_Accept(toggle, now);
+
+    /* Long press: held, not yet reported */
+    uint8_t pending_long = button_held & (uint8_t)~button_long;
+    for (uint8_t i = 0; pending_long && i < BUTTON_COUNT; i++) {
+        if ((pending_long & (1U << i)) &&
+            now - button_press_time[i] >= BUTTON_LONG_PRESS_MS * 1000U) {
+            button_long |= (uint8_t)(1U << i);
+            Button_PushEvent(BUTTON_EVENT_LONG, i, now);
         }
+    }
+
+    __set_PRIMASK(primask);
+
+    /* Consume events */
+    Button_Event ev;
+    while (ButtonControl_GetEvent(&ev)) {
+        switch (ev.type) {
+            case BUTTON_EVENT_PRESS:
+                /* Button pressed - execute movement (manual drive overrides closed loop) */
+                SpeedControl_DisableAll();
+                ButtonControl_LED_On(ev.button);
+                #ifdef USE_UART_TELEMETRY
+                Telemetry_SendButton(ev.button, 1);
+                #endif
+                Button_Drive(ev.button, MOTOR_DEFAULT_SPEED);
+                break;
+
+            case BUTTON_EVENT_LONG:
+                /* Still the only button held - boost */
+                if (ev.mask == (1U << ev.button)) {
+                    Button_Drive(ev.button, MOTOR_LONG_PRESS_SPEED);
+                }
+                break;
+
+            case BUTTON_EVENT_CHORD:
+                /* Several buttons at once - brake everything */
+                DLOG(BUTTON_CHORD, ev.mask);
+                TB6612FNG_BrakeAll();
+                SendAllMotors(MOTOR_STOP, MOTOR_STOP, MOTOR_STOP, MOTOR_STOP, 0);
+                break;
+
+            case BUTTON_EVENT_RELEASE:
+                /* Button released - stop all motors */
+                DLOG(BUTTON_RELEASE, ev.button);
+                TB6612FNG_StopAll();
+                ButtonControl_LED_Off(ev.button);
+
+                #ifdef USE_UART_TELEMETRY
+                Telemetry_SendButton(ev.button, 0);
+                SendAllMotors(MOTOR_STOP, MOTOR_STOP, MOTOR_STOP, MOTOR_STOP, 0);
+                #endif
+                break;
+        }
+    }
+    PROFILE_END(BUTTON_UPDATE);
+}
+
+/**
+ * @brief Button EXTI handlers: accept a new press at once
+ */
+void EXTI3_IRQHandler(void)
+{
+    ISR_STATS_ENTER(BUTTON);
+    if (__HAL_GPIO_EXTI_GET_IT(BTN_0_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(BTN_0_PIN);
+        Button_OnEdge();
+    }
+    ISR_STATS_EXIT(BUTTON);
+}
 
-        button_prev_state[i] = is_pressed;
+void EXTI4_IRQHandler(void)
+{
+    ISR_STATS_ENTER(BUTTON);
+    if (__HAL_GPIO_EXTI_GET_IT(BTN_1_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(BTN_1_PIN);
+        Button_OnEdge();
     }
+    ISR_STATS_EXIT(BUTTON);
+}
 
-    HAL_Delay(10);
+void EXTI15_10_IRQHandler(void)
+{
+    ISR_STATS_ENTER(BUTTON);
+    if (__HAL_GPIO_EXTI_GET_IT(BTN_2_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(BTN_2_PIN);
+        Button_OnEdge();
+    }
+
+    if (__HAL_GPIO_EXTI_GET_IT(BTN_3_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(BTN_3_PIN);
+        Button_OnEdge();
+    }
+    ISR_STATS_EXIT(BUTTON);
 }
@@ -0,0 +1,191 @@
+/**
+ * @file    clock_profile.c
+ * @brief   Runtime-selectable system clock profiles implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "clock_profile.h"
+#include "timebase.h"
+#ifdef USE_UART_TELEMETRY
+#include "uart_telemetry.h"
+#endif
+
+/* PLL and bus settings of a profile (HSE = 25 MHz, PLL input = 1 MHz) */
+typedef struct {
+    const char *name;
+    uint32_t pll_n;
+    uint32_t pll_p;
+    uint32_t pll_q;
+    uint32_t apb1_div;          // PCLK1 <= 50 MHz
+    uint32_t apb2_div;
+    uint32_t flash_latency;     // Wait states at 2.7-3.6 V
+    uint32_t voltage_scale;
+} Clock_ProfileConfig;
+
+static const Clock_ProfileConfig profiles[CLOCK_PROFILE_COUNT] = {
+    /* 200 / 2 = 100 MHz, APB1 50 MHz, APB2 100 MHz */
+    [CLOCK_PROFILE_PERFORMANCE] = {"performance", 200, RCC_PLLP_DIV2, 5,
+                                   RCC_HCLK_DIV2, RCC_HCLK_DIV1, FLASH_LATENCY_3,
+                                   PWR_REGULATOR_VOLTAGE_SCALE1},
+    /* 192 / 2 = 96 MHz, APB1 48 MHz, APB2 96 MHz */
+    [CLOCK_PROFILE_BALANCED]    = {"balanced", 192, RCC_PLLP_DIV2, 4,
+                                   RCC_HCLK_DIV2, RCC_HCLK_DIV1, FLASH_LATENCY_3,
+                                   PWR_REGULATOR_VOLTAGE_SCALE1},
+    /* 192 / 4 = 48 MHz, APB1 48 MHz, APB2 48 MHz */
+    [CLOCK_PROFILE_ECONOMY]     = {"economy", 192, RCC_PLLP_DIV4, 4,
+                                   RCC_HCLK_DIV1, RCC_HCLK_DIV1, FLASH_LATENCY_1,
+                                   PWR_REGULATOR_VOLTAGE_SCALE3}
+};
+
+static Clock_Profile current = CLOCK_PROFILE_DEFAULT;
+static TIM_HandleTypeDef *timers[CLOCK_PROFILE_MAX_TIMERS];
+static uint8_t timer_count = 0;
+
+/**
+ * @brief Program the PLL and buses for a profile
+ * SYSCLK runs from HSE while the PLL is stopped: neither the PLL nor the
+ * voltage scale may change while the PLL drives the system clock.
+ * The timebase is retimed as soon as SYSCLK is on HSE, so TIM5 keeps
+ * counting microseconds through the PLL lock; only the few cycles of
+ * each SYSCLK switch run at the wrong rate (time stays monotonic).
+ */
+static bool ClockProfile_Apply(const Clock_ProfileConfig *p)
+{
+    RCC_OscInitTypeDef osc = {0};
+    RCC_ClkInitTypeDef clk = {0};
+
+    /* 1. HSE on, SYSCLK = HSE */
+    osc.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+    osc.HSEState = RCC_HSE_ON;
+    osc.PLL.PLLState = RCC_PLL_NONE;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) return false;
+
+    clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK |
+                    RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_HSE;
+    clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    clk.APB1CLKDivider = RCC_HCLK_DIV1;
+    clk.APB2CLKDivider = RCC_HCLK_DIV1;
+    if (HAL_RCC_ClockConfig(&clk, __HAL_FLASH_GET_LATENCY()) != HAL_OK) return false;
+    Timebase_Retime();
+
+    /* 2. PLL off, new voltage scale */
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLL.PLLState = RCC_PLL_OFF;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) return false;
+
+    __HAL_RCC_PWR_CLK_ENABLE();
+    __HAL_PWR_VOLTAGESCALING_CONFIG(p->voltage_scale);
+
+    /* 3. PLL on with the profile settings */
+    osc.PLL.PLLState = RCC_PLL_ON;
+    osc.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+    osc.PLL.PLLM = 25;          // 25 MHz / 25 = 1 MHz
+    osc.PLL.PLLN = p->pll_n;
+    osc.PLL.PLLP = p->pll_p;
+    osc.PLL.PLLQ = p->pll_q;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) return false;
+
+    /* 4. SYSCLK = PLL (HAL adjusts flash latency and SysTick) */
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+    clk.APB1CLKDivider = p->apb1_div;
+    clk.APB2CLKDivider = p->apb2_div;
+    if (HAL_RCC_ClockConfig(&clk, p->flash_latency) != HAL_OK) return false;
+
+    return true;
+}
+
+/**
+ * @brief Recompute clock-dependent peripheral settings
+ */
+static void ClockProfile_Retime(void)
+{
+    for (uint8_t i = 0; i < timer_count; i++) {
+        uint32_t psc = ClockProfile_GetTimerPrescaler(timers[i]->Instance);
+        timers[i]->Init.Prescaler = psc;
+        __HAL_TIM_SET_PRESCALER(timers[i], psc);    // Loaded at the next update
+    }
+
+    #ifdef USE_UART_TELEMETRY
+    if (huart1.Instance != NULL) {
+        huart1.Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK2Freq(),
+                                                   huart1.Init.BaudRate);
+    }
+    #endif
+
+    Timebase_Retime();
+}
+
+void ClockProfile_Init(Clock_Profile profile)
+{
+    if (profile >= CLOCK_PROFILE_COUNT) profile = CLOCK_PROFILE_DEFAULT;
+
+    timer_count = 0;
+    if (!ClockProfile_Apply(&profiles[profile])) {
+        Error_Handler();
+    }
+    current = profile;
+}
+
+bool ClockProfile_AddTimer(TIM_HandleTypeDef *htim)
+{
+    if (timer_count >= CLOCK_PROFILE_MAX_TIMERS || htim == NULL) return false;
+    timers[timer_count++] = htim;
+    return true;
+}
+
+bool ClockProfile_Set(Clock_Profile profile)
+{
+    if (profile >= CLOCK_PROFILE_COUNT) return false;
+    if (profile == current) return true;
+
+    #ifdef USE_UART_TELEMETRY
+    /* Let the last reply leave the shift register before BRR changes */
+    uint32_t deadline = Timebase_Deadline(10000);
+    while (huart1.Instance != NULL && !__HAL_UART_GET_FLAG(&huart1, UART_FLAG_TC) &&
+           !Timebase_Expired(deadline)) {
+    }
+    #endif
+
+    /* Control tick paused while timer prescalers and SystemCoreClock change */
+    HAL_NVIC_DisableIRQ(TIM1_BRK_TIM9_IRQn);
+
+    bool ok = ClockProfile_Apply(&profiles[profile]);
+    if (ok) {
+        current = profile;
+    } else {
+        /* Fall back to a known-good configuration */
+        ClockProfile_Apply(&profiles[current]);
+    }
+    ClockProfile_Retime();
+
+    HAL_NVIC_EnableIRQ(TIM1_BRK_TIM9_IRQn);
+    return ok;
+}
+
+Clock_Profile ClockProfile_Get(void)
+{
+    return current;
+}
+
+const char *ClockProfile_GetName(Clock_Profile profile)
+{
+    if (profile >= CLOCK_PROFILE_COUNT) return "unknown";
+    return profiles[profile].name;
+}
+
+uint32_t ClockProfile_GetTimerClock(const TIM_TypeDef *tim)
+{
+    bool apb2 = (tim == TIM1 || tim == TIM9 || tim == TIM10 || tim == TIM11);
+    uint32_t pclk = apb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    uint32_t ppre = apb2 ? (RCC->CFGR & RCC_CFGR_PPRE2) : (RCC->CFGR & RCC_CFGR_PPRE1);
+
+    /* Divider 1 -> timer clock = PCLK, otherwise 2 x PCLK */
+    return (ppre == 0) ? pclk : 2U * pclk;
+}
+
+uint32_t ClockProfile_GetTimerPrescaler(const TIM_TypeDef *tim)
+{
+    return ClockProfile_GetTimerClock(tim) / CLOCK_TIMER_TICK_HZ - 1;
+}
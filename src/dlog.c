@@ -0,0 +1,75 @@
+/**
+ * @file    dlog.c
+ * @brief   Deferred binary logging implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "dlog.h"
+#include "timebase.h"
+
+static uint32_t dlog_buffer[DLOG_BUFFER_WORDS];
+static volatile uint32_t dlog_head = 0;        // Words written
+static volatile uint32_t dlog_tail = 0;        // Words read
+static volatile uint32_t dlog_dropped = 0;     // Messages lost since last read
+
+void Dlog_Init(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    dlog_head = 0;
+    dlog_tail = 0;
+    dlog_dropped = 0;
+    __set_PRIMASK(primask);
+}
+
+void Dlog_Write(Dlog_Id id, const uint32_t *args, uint8_t nargs)
+{
+    if (nargs > DLOG_MAX_ARGS) nargs = DLOG_MAX_ARGS;
+    uint32_t words = DLOG_RECORD_WORDS(nargs);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t head = dlog_head;
+    if (DLOG_BUFFER_WORDS - (head - dlog_tail) < words) {
+        dlog_dropped++;
+        __set_PRIMASK(primask);
+        return;
+    }
+    dlog_buffer[head++ & (DLOG_BUFFER_WORDS - 1)] = (uint32_t)id | ((uint32_t)nargs << 16);
+    dlog_buffer[head++ & (DLOG_BUFFER_WORDS - 1)] = Timebase_NowUs();
+    for (uint8_t i = 0; i < nargs; i++) {
+        dlog_buffer[head++ & (DLOG_BUFFER_WORDS - 1)] = args[i];
+    }
+    dlog_head = head;
+    __set_PRIMASK(primask);
+}
+
+uint8_t Dlog_Read(uint32_t *out, uint8_t max)
+{
+    uint8_t n = 0;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t tail = dlog_tail;
+    while (tail != dlog_head) {
+        uint32_t words = DLOG_RECORD_WORDS((dlog_buffer[tail & (DLOG_BUFFER_WORDS - 1)] >> 16) & 0xFF);
+        if (n + words > max) break;
+        for (uint32_t i = 0; i < words; i++) {
+            out[n++] = dlog_buffer[tail++ & (DLOG_BUFFER_WORDS - 1)];
+        }
+    }
+    dlog_tail = tail;
+
+    /* Messages were dropped after everything in the ring: report once drained */
+    if (dlog_dropped > 0 && tail == dlog_head && n + DLOG_RECORD_WORDS(1) <= max) {
+        out[n++] = (uint32_t)DLOG_DROPPED | (1UL << 16);
+        out[n++] = Timebase_NowUs();
+        out[n++] = dlog_dropped;
+        dlog_dropped = 0;
+    }
+
+    __set_PRIMASK(primask);
+    return n;
+}
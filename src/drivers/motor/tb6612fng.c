@@ -6,6 +6,7 @@
  */
 
 #include "tb6612fng.h"
+#include "trace.h"
 
 // ============================================================================
 // Private Variables
@@ -238,6 +239,11 @@ void TB6612FNG_SetDirection(Motor_ID motor, Motor_Direction direction) {
 void TB6612FNG_Drive(Motor_ID motor, Motor_Direction direction, uint8_t speed) {
     if (!is_initialized || motor >= MOTOR_COUNT) return;
 
+    // Trace changes only (the control tick drives every motor at 500 Hz)
+    if (direction != motor_directions[motor] || speed != motor_speeds[motor]) {
+        TRACE(MOTOR, motor, ((uint32_t)direction << 8) | speed);
+    }
+
     SetMotorDirection(motor, direction);
     SetMotorPWM(motor, speed);
 }
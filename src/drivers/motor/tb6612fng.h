@@ -11,6 +11,7 @@
 #define TB6612FNG_H
 
 #include "main.h"
+#include "pin_map.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -63,51 +64,64 @@ typedef struct {
 
 // ============================================================================
 // Pin Definitions - Driver 1 (Motors 0, 1)
+// Assignments live in pin_map.h (checked there for conflicts)
 // ============================================================================
 
 // Motor 0 (Driver 1, Channel A)
-#define MOTOR_0_IN1_PORT        GPIOB
-#define MOTOR_0_IN1_PIN         GPIO_PIN_1
-#define MOTOR_0_IN2_PORT        GPIOB
-#define MOTOR_0_IN2_PIN         GPIO_PIN_10
-#define MOTOR_0_PWM_TIMER       TIM3
-#define MOTOR_0_PWM_CHANNEL     TIM_CHANNEL_3  // PB0
+#define MOTOR_0_IN1_PORT        PINMAP_PORT(PIN_MOTOR_0_IN1)
+#define MOTOR_0_IN1_PIN         PINMAP_PIN(PIN_MOTOR_0_IN1)
+#define MOTOR_0_IN2_PORT        PINMAP_PORT(PIN_MOTOR_0_IN2)
+#define MOTOR_0_IN2_PIN         PINMAP_PIN(PIN_MOTOR_0_IN2)
+#define MOTOR_0_PWM_PORT        PINMAP_PORT(PIN_MOTOR_0_PWM)
+#define MOTOR_0_PWM_PIN         PINMAP_PIN(PIN_MOTOR_0_PWM)
+#define MOTOR_0_PWM_TIMER       PINMAP_TIM(TIM_MOTOR_0_PWM)
+#define MOTOR_0_PWM_CHANNEL     PINMAP_CHANNEL(TIM_MOTOR_0_PWM)  // PB0
+#define MOTOR_0_PWM_AF          AF_MOTOR_0_PWM
 
 // Motor 1 (Driver 1, Channel B)
-#define MOTOR_1_IN1_PORT        GPIOB
-#define MOTOR_1_IN1_PIN         GPIO_PIN_12
-#define MOTOR_1_IN2_PORT        GPIOB
-#define MOTOR_1_IN2_PIN         GPIO_PIN_13
-#define MOTOR_1_PWM_TIMER       TIM4
-#define MOTOR_1_PWM_CHANNEL     TIM_CHANNEL_2  // PB7
+#define MOTOR_1_IN1_PORT        PINMAP_PORT(PIN_MOTOR_1_IN1)
+#define MOTOR_1_IN1_PIN         PINMAP_PIN(PIN_MOTOR_1_IN1)
+#define MOTOR_1_IN2_PORT        PINMAP_PORT(PIN_MOTOR_1_IN2)
+#define MOTOR_1_IN2_PIN         PINMAP_PIN(PIN_MOTOR_1_IN2)
+#define MOTOR_1_PWM_PORT        PINMAP_PORT(PIN_MOTOR_1_PWM)
+#define MOTOR_1_PWM_PIN         PINMAP_PIN(PIN_MOTOR_1_PWM)
+#define MOTOR_1_PWM_TIMER       PINMAP_TIM(TIM_MOTOR_1_PWM)
+#define MOTOR_1_PWM_CHANNEL     PINMAP_CHANNEL(TIM_MOTOR_1_PWM)  // PB7
+#define MOTOR_1_PWM_AF          AF_MOTOR_1_PWM
 
 // Driver 1 Standby
-#define DRIVER_1_STBY_PORT      GPIOB
-#define DRIVER_1_STBY_PIN       GPIO_PIN_14
+#define DRIVER_1_STBY_PORT      PINMAP_PORT(PIN_DRIVER_1_STBY)
+#define DRIVER_1_STBY_PIN       PINMAP_PIN(PIN_DRIVER_1_STBY)
 
 // ============================================================================
 // Pin Definitions - Driver 2 (Motors 2, 3)
 // ============================================================================
 
 // Motor 2 (Driver 2, Channel A)
-#define MOTOR_2_IN1_PORT        GPIOA
-#define MOTOR_2_IN1_PIN         GPIO_PIN_0
-#define MOTOR_2_IN2_PORT        GPIOA
-#define MOTOR_2_IN2_PIN         GPIO_PIN_1
-#define MOTOR_2_PWM_TIMER       TIM1
-#define MOTOR_2_PWM_CHANNEL     TIM_CHANNEL_1  // PA8
+#define MOTOR_2_IN1_PORT        PINMAP_PORT(PIN_MOTOR_2_IN1)
+#define MOTOR_2_IN1_PIN         PINMAP_PIN(PIN_MOTOR_2_IN1)
+#define MOTOR_2_IN2_PORT        PINMAP_PORT(PIN_MOTOR_2_IN2)
+#define MOTOR_2_IN2_PIN         PINMAP_PIN(PIN_MOTOR_2_IN2)
+#define MOTOR_2_PWM_PORT        PINMAP_PORT(PIN_MOTOR_2_PWM)
+#define MOTOR_2_PWM_PIN         PINMAP_PIN(PIN_MOTOR_2_PWM)
+#define MOTOR_2_PWM_TIMER       PINMAP_TIM(TIM_MOTOR_2_PWM)
+#define MOTOR_2_PWM_CHANNEL     PINMAP_CHANNEL(TIM_MOTOR_2_PWM)  // PA8
+#define MOTOR_2_PWM_AF          AF_MOTOR_2_PWM
 
 // Motor 3 (Driver 2, Channel B)
-#define MOTOR_3_IN1_PORT        GPIOA
-#define MOTOR_3_IN1_PIN         GPIO_PIN_2
-#define MOTOR_3_IN2_PORT        GPIOA
-#define MOTOR_3_IN2_PIN         GPIO_PIN_3
-#define MOTOR_3_PWM_TIMER       TIM2
-#define MOTOR_3_PWM_CHANNEL     TIM_CHANNEL_1  // PA15
+#define MOTOR_3_IN1_PORT        PINMAP_PORT(PIN_MOTOR_3_IN1)
+#define MOTOR_3_IN1_PIN         PINMAP_PIN(PIN_MOTOR_3_IN1)
+#define MOTOR_3_IN2_PORT        PINMAP_PORT(PIN_MOTOR_3_IN2)
+#define MOTOR_3_IN2_PIN         PINMAP_PIN(PIN_MOTOR_3_IN2)
+#define MOTOR_3_PWM_PORT        PINMAP_PORT(PIN_MOTOR_3_PWM)
+#define MOTOR_3_PWM_PIN         PINMAP_PIN(PIN_MOTOR_3_PWM)
+#define MOTOR_3_PWM_TIMER       PINMAP_TIM(TIM_MOTOR_3_PWM)
+#define MOTOR_3_PWM_CHANNEL     PINMAP_CHANNEL(TIM_MOTOR_3_PWM)  // PA15
+#define MOTOR_3_PWM_AF          AF_MOTOR_3_PWM
 
 // Driver 2 Standby
-#define DRIVER_2_STBY_PORT      GPIOA
-#define DRIVER_2_STBY_PIN       GPIO_PIN_4
+#define DRIVER_2_STBY_PORT      PINMAP_PORT(PIN_DRIVER_2_STBY)
+#define DRIVER_2_STBY_PIN       PINMAP_PIN(PIN_DRIVER_2_STBY)
 
 // ============================================================================
 // Public API Functions
@@ -6,6 +6,8 @@
  */
 
 #include "encoder.h"
+#include "isr_stats.h"
+#include "timebase.h"
 
 // ============================================================================
 // ПРИВАТНЫЕ ПЕРЕМЕННЫЕ
@@ -15,7 +17,40 @@
 static volatile uint32_t pulse_count[ENCODER_COUNT] = {0, 0, 0, 0};
 static volatile uint32_t last_count[ENCODER_COUNT] = {0, 0, 0, 0};
 static volatile uint32_t last_time[ENCODER_COUNT] = {0, 0, 0, 0};
-static float rpm[ENCODER_COUNT] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+// Опорный фронт для расчёта скорости по времени между фронтами (мкс, TIM5)
+static uint32_t ref_edge[ENCODER_COUNT] = {0, 0, 0, 0};
+static bool ref_edge_valid[ENCODER_COUNT] = {false, false, false, false};
+
+// Фильтрация дребезга: время последнего принятого фронта (мкс),
+// минимальный период (мкс) и счётчик отброшенных фронтов
+static volatile uint32_t last_edge[ENCODER_COUNT] = {0, 0, 0, 0};
+static uint32_t min_period_us[ENCODER_COUNT] = {0, 0, 0, 0};
+static volatile uint32_t glitch_count[ENCODER_COUNT] = {0, 0, 0, 0};
+
+// Скорость в формате Q16.16: сырая и после фильтра
+static q16_t raw_rpm[ENCODER_COUNT] = {0, 0, 0, 0};
+static VFilter rpm_filter[ENCODER_COUNT];
+
+// ============================================================================
+// ПРИВАТНЫЕ ФУНКЦИИ
+// ============================================================================
+
+/**
+ * @brief Обработать фронт энкодера (вызывается из прерывания)
+ * Фронт засчитывается, только если с предыдущего прошло не меньше min_period
+ */
+static inline void Encoder_HandleEdge(Encoder_ID encoder) {
+    uint32_t now = Timebase_NowUs();
+
+    if (now - last_edge[encoder] < min_period_us[encoder]) {
+        glitch_count[encoder]++;
+        return;
+    }
+
+    last_edge[encoder] = now;
+    pulse_count[encoder]++;
+}
 
 // ============================================================================
 // ПУБЛИЧНЫЕ ФУНКЦИИ
@@ -27,8 +62,13 @@ static float rpm[ENCODER_COUNT] = {0.0f, 0.0f, 0.0f, 0.0f};
 void Encoder_Init(void) {
     GPIO_InitTypeDef GPIO_InitStruct = {0};
 
+    // Фильтры скорости и минимальный период фронтов
+    for (uint8_t i = 0; i < ENCODER_COUNT; i++) {
+        VFilter_Init(&rpm_filter[i], ENCODER_DEFAULT_FILTER);
+        Encoder_SetMinPeriod((Encoder_ID)i, ENCODER_MIN_PERIOD_US);
+    }
+
     // Включить тактирование GPIO
-    __HAL_RCC_GPIOA_CLK_ENABLE();
     __HAL_RCC_GPIOB_CLK_ENABLE();
 
     // Настройка GPIO как входа с прерыванием по нарастающему фронту
@@ -37,28 +77,22 @@ void Encoder_Init(void) {
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
 
     // Encoder 0 - PB6
-    GPIO_InitStruct.Pin = GPIO_PIN_6;
-    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-
-    // Encoder 1 - PB7
-    GPIO_InitStruct.Pin = GPIO_PIN_7;
-    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-
-    // Encoder 2 - PA2
-    GPIO_InitStruct.Pin = GPIO_PIN_2;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = ENCODER_0_PIN;
+    HAL_GPIO_Init(ENCODER_0_PORT, &GPIO_InitStruct);
 
-    // Encoder 3 - PA3
-    GPIO_InitStruct.Pin = GPIO_PIN_3;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    // Encoder 1 - PB5
+    GPIO_InitStruct.Pin = ENCODER_1_PIN;
+    HAL_GPIO_Init(ENCODER_1_PORT, &GPIO_InitStruct);
 
-    // Включить прерывания EXTI
-    HAL_NVIC_SetPriority(EXTI2_IRQn, 5, 0);
-    HAL_NVIC_EnableIRQ(EXTI2_IRQn);
+    // Encoder 2 - PB8
+    GPIO_InitStruct.Pin = ENCODER_2_PIN;
+    HAL_GPIO_Init(ENCODER_2_PORT, &GPIO_InitStruct);
 
-    HAL_NVIC_SetPriority(EXTI3_IRQn, 5, 0);
-    HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+    // Encoder 3 - PB9
+    GPIO_InitStruct.Pin = ENCODER_3_PIN;
+    HAL_GPIO_Init(ENCODER_3_PORT, &GPIO_InitStruct);
 
+    // Включить прерывание EXTI (все энкодеры на линиях 5..9)
     HAL_NVIC_SetPriority(EXTI9_5_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
 }
@@ -70,7 +104,10 @@ void Encoder_ResetCount(Encoder_ID encoder) {
     if (encoder < ENCODER_COUNT) {
         pulse_count[encoder] = 0;
         last_count[encoder] = 0;
-        rpm[encoder] = 0.0f;
+        ref_edge_valid[encoder] = false;
+        glitch_count[encoder] = 0;
+        raw_rpm[encoder] = 0;
+        VFilter_Reset(&rpm_filter[encoder]);
     }
 }
 
@@ -89,34 +126,123 @@ uint32_t Encoder_GetCount(Encoder_ID encoder) {
  */
 float Encoder_GetRPM(Encoder_ID encoder) {
     if (encoder < ENCODER_COUNT) {
-        return rpm[encoder];
+        return Q16_TO_FLOAT(rpm_filter[encoder].output);
     }
     return 0.0f;
 }
 
 /**
- * @brief Обновить расчёт RPM (вызывать каждые 100мс)
+ * @brief Получить нефильтрованный RPM
+ */
+float Encoder_GetRawRPM(Encoder_ID encoder) {
+    if (encoder < ENCODER_COUNT) {
+        return Q16_TO_FLOAT(raw_rpm[encoder]);
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief Получить ускорение (RPM/с)
+ */
+float Encoder_GetAcceleration(Encoder_ID encoder) {
+    if (encoder < ENCODER_COUNT) {
+        return Q16_TO_FLOAT(rpm_filter[encoder].accel);
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief Выбрать фильтр скорости
+ */
+void Encoder_SetFilter(Encoder_ID encoder, VFilter_Type type) {
+    if (encoder < ENCODER_COUNT) {
+        VFilter_Init(&rpm_filter[encoder], type);
+    }
+}
+
+/**
+ * @brief Доступ к фильтру для настройки коэффициентов
+ */
+VFilter *Encoder_GetFilter(Encoder_ID encoder) {
+    if (encoder < ENCODER_COUNT) {
+        return &rpm_filter[encoder];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Задать минимальный период между фронтами
+ */
+void Encoder_SetMinPeriod(Encoder_ID encoder, uint32_t period_us) {
+    if (encoder < ENCODER_COUNT) {
+        min_period_us[encoder] = period_us;
+    }
+}
+
+/**
+ * @brief Получить количество отброшенных фронтов
+ */
+uint32_t Encoder_GetGlitchCount(Encoder_ID encoder) {
+    if (encoder < ENCODER_COUNT) {
+        return glitch_count[encoder];
+    }
+    return 0;
+}
+
+/**
+ * @brief Обновить расчёт RPM
+ * Скорость считается по времени между фронтами (метод M/T): импульсы за окно
+ * делятся на время от последнего фронта прошлого окна до последнего фронта
+ * текущего. RPM остаётся точным и при вызове из регулятора (500 Гц), когда
+ * за период приходит 0-1 импульс.
  */
 void Encoder_Update(void) {
-    uint32_t current_time = HAL_GetTick();
+    uint32_t now = Timebase_NowUs();
 
     for (uint8_t i = 0; i < ENCODER_COUNT; i++) {
-        // Количество импульсов за промежуток времени
-        uint32_t pulses = pulse_count[i] - last_count[i];
-        uint32_t time_diff = current_time - last_time[i];
+        // Счётчик и время фронта читаются согласованно
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint32_t count = pulse_count[i];
+        uint32_t edge = last_edge[i];
+        __set_PRIMASK(primask);
 
-        if (time_diff > 0) {
-            // RPM = (импульсы * 60000 мс) / (время_мс * прорезы_на_оберт)
-            rpm[i] = (pulses * 60000.0f) / (time_diff * ENCODER_SLOTS_PER_REV);
+        uint32_t pulses = count - last_count[i];
+        uint32_t dt_us = now - last_time[i];
+
+        if (pulses > 0) {
+            uint32_t span_us = edge - ref_edge[i];
+
+            // RPM = импульсы * 60e6 мкс / (время_мкс * прорезы_на_оборот), Q16.16
+            if (ref_edge_valid[i] && span_us > 0) {
+                raw_rpm[i] = (q16_t)(((uint64_t)pulses * 60000000u << Q16_SHIFT) /
+                                     ((uint64_t)span_us * ENCODER_SLOTS_PER_REV));
+            }
+            ref_edge[i] = edge;
+            ref_edge_valid[i] = true;
+        } else if (ref_edge_valid[i]) {
+            uint32_t since_us = now - ref_edge[i];
+
+            if (since_us > ENCODER_STOP_TIMEOUT_US) {
+                // Долго нет импульсов - мотор остановился
+                raw_rpm[i] = 0;
+                ref_edge_valid[i] = false;
+            } else if (since_us > 0) {
+                // Импульса ещё нет: скорость не больше, чем если бы он пришёл сейчас
+                q16_t bound = (q16_t)(((uint64_t)60000000u << Q16_SHIFT) /
+                                      ((uint64_t)since_us * ENCODER_SLOTS_PER_REV));
+                if (bound < raw_rpm[i]) {
+                    raw_rpm[i] = bound;
+                }
+            }
         }
 
-        // Если долго нет импульсов - мотор остановился
-        if (time_diff > 500) {  // 500мс без импульсов
-            rpm[i] = 0.0f;
+        if (dt_us > 0) {
+            VFilter_Update(&rpm_filter[i], raw_rpm[i], dt_us);
         }
 
-        last_count[i] = pulse_count[i];
-        last_time[i] = current_time;
+        last_count[i] = count;
+        last_time[i] = now;
     }
 }
 
@@ -125,38 +251,30 @@ void Encoder_Update(void) {
 // ============================================================================
 
 /**
- * @brief Обработчик прерывания для PB6 и PB7 (EXTI9_5)
+ * @brief Обработчик прерывания для энкодеров (EXTI9_5: PB5, PB6, PB8, PB9)
  */
 void EXTI9_5_IRQHandler(void) {
-    // Encoder 0 - PB6
-    if (__HAL_GPIO_EXTI_GET_IT(GPIO_PIN_6) != RESET) {
-        __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_6);
-        pulse_count[ENCODER_0]++;
+    ISR_STATS_ENTER(ENCODER);
+
+    if (__HAL_GPIO_EXTI_GET_IT(ENCODER_0_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(ENCODER_0_PIN);
+        Encoder_HandleEdge(ENCODER_0);
     }
 
-    // Encoder 1 - PB7
-    if (__HAL_GPIO_EXTI_GET_IT(GPIO_PIN_7) != RESET) {
-        __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_7);
-        pulse_count[ENCODER_1]++;
+    if (__HAL_GPIO_EXTI_GET_IT(ENCODER_1_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(ENCODER_1_PIN);
+        Encoder_HandleEdge(ENCODER_1);
     }
-}
 
-/**
- * @brief Обработчик прерывания для PA2 (EXTI2)
- */
-void EXTI2_IRQHandler(void) {
-    if (__HAL_GPIO_EXTI_GET_IT(GPIO_PIN_2) != RESET) {
-        __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_2);
-        pulse_count[ENCODER_2]++;
+    if (__HAL_GPIO_EXTI_GET_IT(ENCODER_2_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(ENCODER_2_PIN);
+        Encoder_HandleEdge(ENCODER_2);
     }
-}
 
-/**
- * @brief Обработчик прерывания для PA3 (EXTI3)
- */
-void EXTI3_IRQHandler(void) {
-    if (__HAL_GPIO_EXTI_GET_IT(GPIO_PIN_3) != RESET) {
-        __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_3);
-        pulse_count[ENCODER_3]++;
+    if (__HAL_GPIO_EXTI_GET_IT(ENCODER_3_PIN) != RESET) {
+        __HAL_GPIO_EXTI_CLEAR_IT(ENCODER_3_PIN);
+        Encoder_HandleEdge(ENCODER_3);
     }
+
+    ISR_STATS_EXIT(ENCODER);
 }
@@ -9,21 +9,53 @@
 #define ENCODER_H
 
 #include "main.h"
+#include "pin_map.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include "velocity_filter.h"
 
 // Количество прорезов на диске энкодера
 #define ENCODER_SLOTS_PER_REV   20
 
+// Максимальная правдоподобная скорость колеса (RPM)
+#define ENCODER_MAX_RPM         600
+
+// Минимальный период между фронтами (мкс): половина периода на ENCODER_MAX_RPM.
+// Фронты ближе этого считаются дребезгом/помехой от PWM и отбрасываются.
+#define ENCODER_MIN_PERIOD_US   (60000000UL / (ENCODER_MAX_RPM * ENCODER_SLOTS_PER_REV) / 2)
+
+// Нет импульсов дольше этого времени (мкс) - колесо стоит
+#define ENCODER_STOP_TIMEOUT_US 500000UL
+
+// Фильтр скорости по умолчанию (см. velocity_filter.h)
+#define ENCODER_DEFAULT_FILTER  VFILTER_IIR
+
 // Идентификаторы энкодеров
 typedef enum {
     ENCODER_0 = 0,  // Motor 0 - PB6
-    ENCODER_1 = 1,  // Motor 1 - PB7
-    ENCODER_2 = 2,  // Motor 2 - PA2
-    ENCODER_3 = 3,  // Motor 3 - PA3
+    ENCODER_1 = 1,  // Motor 1 - PB5
+    ENCODER_2 = 2,  // Motor 2 - PB8
+    ENCODER_3 = 3,  // Motor 3 - PB9
     ENCODER_COUNT = 4
 } Encoder_ID;
 
+// Пины энкодеров (назначение в pin_map.h, все линии на EXTI9_5).
+// Прежние PB7/PA2/PA3 совпадали с PWM Motor 1 и IN1/IN2 Motor 3.
+#define ENCODER_0_PORT          PINMAP_PORT(PIN_ENCODER_0)
+#define ENCODER_0_PIN           PINMAP_PIN(PIN_ENCODER_0)
+#define ENCODER_1_PORT          PINMAP_PORT(PIN_ENCODER_1)
+#define ENCODER_1_PIN           PINMAP_PIN(PIN_ENCODER_1)
+#define ENCODER_2_PORT          PINMAP_PORT(PIN_ENCODER_2)
+#define ENCODER_2_PIN           PINMAP_PIN(PIN_ENCODER_2)
+#define ENCODER_3_PORT          PINMAP_PORT(PIN_ENCODER_3)
+#define ENCODER_3_PIN           PINMAP_PIN(PIN_ENCODER_3)
+
+_Static_assert(PINMAP_NUMBER(PIN_ENCODER_0) >= 5 && PINMAP_NUMBER(PIN_ENCODER_0) <= 9 &&
+               PINMAP_NUMBER(PIN_ENCODER_1) >= 5 && PINMAP_NUMBER(PIN_ENCODER_1) <= 9 &&
+               PINMAP_NUMBER(PIN_ENCODER_2) >= 5 && PINMAP_NUMBER(PIN_ENCODER_2) <= 9 &&
+               PINMAP_NUMBER(PIN_ENCODER_3) >= 5 && PINMAP_NUMBER(PIN_ENCODER_3) <= 9,
+               "encoder.h: encoder pins must use EXTI lines 5..9 (EXTI9_5_IRQHandler)");
+
 // ============================================================================
 // ПУБЛИЧНЫЕ ФУНКЦИИ
 // ============================================================================
@@ -54,9 +86,52 @@ uint32_t Encoder_GetCount(Encoder_ID encoder);
  */
 float Encoder_GetRPM(Encoder_ID encoder);
 
+/**
+ * @brief Получить нефильтрованную скорость (RPM)
+ * @param encoder ID энкодера
+ * @return Скорость последнего измерения без фильтра
+ */
+float Encoder_GetRawRPM(Encoder_ID encoder);
+
+/**
+ * @brief Получить ускорение
+ * @param encoder ID энкодера
+ * @return Ускорение в RPM/с (оценка alpha-beta или разность отфильтрованной скорости)
+ */
+float Encoder_GetAcceleration(Encoder_ID encoder);
+
+/**
+ * @brief Выбрать фильтр скорости для энкодера
+ * @param encoder ID энкодера
+ * @param type Тип фильтра (VFILTER_NONE, VFILTER_IIR, VFILTER_MEDIAN, VFILTER_ALPHA_BETA)
+ * @note Коэффициенты сбрасываются на значения по умолчанию
+ */
+void Encoder_SetFilter(Encoder_ID encoder, VFilter_Type type);
+
+/**
+ * @brief Доступ к фильтру для настройки коэффициентов
+ * @param encoder ID энкодера
+ * @return Указатель на состояние фильтра или NULL
+ */
+VFilter *Encoder_GetFilter(Encoder_ID encoder);
+
+/**
+ * @brief Задать минимальный период между фронтами
+ * @param encoder ID энкодера
+ * @param period_us Период в мкс (0 - фильтрация отключена)
+ */
+void Encoder_SetMinPeriod(Encoder_ID encoder, uint32_t period_us);
+
+/**
+ * @brief Получить количество отброшенных фронтов (дребезг, помехи)
+ * @param encoder ID энкодера
+ * @return Количество отброшенных фронтов с момента сброса
+ */
+uint32_t Encoder_GetGlitchCount(Encoder_ID encoder);
+
 /**
  * @brief Обновить расчёт RPM
- * @note Вызывать периодически каждые 100 мс
+ * @note Вызывать периодически (из регулятора скорости, 1-100 мс)
  */
 void Encoder_Update(void);
 
@@ -0,0 +1,131 @@
+/**
+ * @file    velocity_filter.c
+ * @brief   Fixed-point velocity filter bank implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "velocity_filter.h"
+
+// ============================================================================
+// Private Functions
+// ============================================================================
+
+/**
+ * @brief Clamp 64-bit intermediate to Q16.16 range
+ * @note Acceleration = delta / dt grows large at short control periods
+ */
+static q16_t Saturate(int64_t value) {
+    if (value > INT32_MAX) return INT32_MAX;
+    if (value < INT32_MIN) return INT32_MIN;
+    return (q16_t)value;
+}
+
+/**
+ * @brief Median of the filled part of the window (insertion sort on a copy)
+ */
+static q16_t MedianOfWindow(const VFilter *filter) {
+    q16_t sorted[VFILTER_MEDIAN_WINDOW];
+    uint8_t n = filter->window_fill;
+
+    for (uint8_t i = 0; i < n; i++) {
+        q16_t v = filter->window[i];
+        int8_t j = (int8_t)i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+
+    return sorted[n / 2];
+}
+
+/**
+ * @brief Alpha-beta tracker step
+ *   predict:  x' = x + v * dt
+ *   correct:  x  = x' + alpha * r,  v = v + beta * r / dt   (r = z - x')
+ */
+static void AlphaBetaStep(VFilter *filter, q16_t sample, uint32_t dt_us) {
+    q16_t predicted = filter->output +
+                      (q16_t)(((int64_t)filter->accel * dt_us) / 1000000);
+    q16_t residual = sample - predicted;
+
+    filter->output = predicted + Q16_MUL(filter->alpha, residual);
+    filter->accel = Saturate(filter->accel +
+                             ((int64_t)Q16_MUL(filter->beta, residual) * 1000000) / dt_us);
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void VFilter_Init(VFilter *filter, VFilter_Type type) {
+    filter->type = type;
+    filter->alpha = (type == VFILTER_ALPHA_BETA) ? VFILTER_AB_ALPHA_DEFAULT
+                                                 : VFILTER_IIR_ALPHA_DEFAULT;
+    filter->beta = VFILTER_AB_BETA_DEFAULT;
+    VFilter_Reset(filter);
+}
+
+void VFilter_Reset(VFilter *filter) {
+    filter->output = 0;
+    filter->accel = 0;
+    filter->primed = false;
+    filter->window_pos = 0;
+    filter->window_fill = 0;
+}
+
+void VFilter_SetIIR(VFilter *filter, q16_t alpha) {
+    if (alpha <= 0 || alpha > Q16_ONE) return;
+    filter->alpha = alpha;
+}
+
+void VFilter_SetAlphaBeta(VFilter *filter, q16_t alpha, q16_t beta) {
+    if (alpha <= 0 || alpha > Q16_ONE || beta <= 0 || beta > Q16_ONE) return;
+    filter->alpha = alpha;
+    filter->beta = beta;
+}
+
+q16_t VFilter_Update(VFilter *filter, q16_t sample, uint32_t dt_us) {
+    if (dt_us == 0) dt_us = 1;
+
+    // First sample: start from the measured value instead of ramping from 0
+    if (!filter->primed) {
+        filter->output = sample;
+        filter->accel = 0;
+        filter->window[0] = sample;
+        filter->window_pos = 1;
+        filter->window_fill = 1;
+        filter->primed = true;
+        return sample;
+    }
+
+    q16_t previous = filter->output;
+
+    switch (filter->type) {
+        case VFILTER_IIR:
+            filter->output += Q16_MUL(filter->alpha, sample - filter->output);
+            break;
+
+        case VFILTER_MEDIAN:
+            filter->window[filter->window_pos] = sample;
+            filter->window_pos = (filter->window_pos + 1) % VFILTER_MEDIAN_WINDOW;
+            if (filter->window_fill < VFILTER_MEDIAN_WINDOW) filter->window_fill++;
+            filter->output = MedianOfWindow(filter);
+            break;
+
+        case VFILTER_ALPHA_BETA:
+            AlphaBetaStep(filter, sample, dt_us);
+            return filter->output;
+
+        case VFILTER_NONE:
+        default:
+            filter->output = sample;
+            break;
+    }
+
+    // Finite-difference acceleration for filters without a velocity state
+    filter->accel = Saturate(((int64_t)(filter->output - previous) * 1000000) / dt_us);
+    return filter->output;
+}
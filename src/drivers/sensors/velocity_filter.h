@@ -0,0 +1,111 @@
+/**
+ * @file    velocity_filter.h
+ * @brief   Fixed-point velocity filter bank for encoder speed
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Allocation-free filters working on Q16.16 RPM samples:
+ *  - VFILTER_IIR        first-order low-pass (exponential smoothing)
+ *  - VFILTER_MEDIAN     5-sample median, rejects single-slot jitter spikes
+ *  - VFILTER_ALPHA_BETA alpha-beta tracker, also estimates acceleration
+ */
+
+#ifndef VELOCITY_FILTER_H
+#define VELOCITY_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Fixed-point helpers (Q16.16)
+// ============================================================================
+
+typedef int32_t q16_t;
+
+#define Q16_SHIFT               16
+#define Q16_ONE                 ((q16_t)1 << Q16_SHIFT)
+#define Q16_FROM_INT(x)         ((q16_t)((x) * Q16_ONE))
+#define Q16_FROM_FLOAT(x)       ((q16_t)((x) * 65536.0f))
+#define Q16_TO_FLOAT(x)         ((float)(x) / 65536.0f)
+#define Q16_MUL(a, b)           ((q16_t)(((int64_t)(a) * (b)) >> Q16_SHIFT))
+
+// ============================================================================
+// Filter Configuration
+// ============================================================================
+
+/**
+ * @brief Filter stage types
+ */
+typedef enum {
+    VFILTER_NONE       = 0,  // Pass-through (raw RPM)
+    VFILTER_IIR        = 1,  // y += alpha * (x - y)
+    VFILTER_MEDIAN     = 2,  // Median of last VFILTER_MEDIAN_WINDOW samples
+    VFILTER_ALPHA_BETA = 3   // Position/velocity tracker on RPM/acceleration
+} VFilter_Type;
+
+#define VFILTER_MEDIAN_WINDOW       5
+
+// Default coefficients (Q16.16)
+#define VFILTER_IIR_ALPHA_DEFAULT   Q16_FROM_FLOAT(0.25f)
+#define VFILTER_AB_ALPHA_DEFAULT    Q16_FROM_FLOAT(0.50f)
+#define VFILTER_AB_BETA_DEFAULT     Q16_FROM_FLOAT(0.10f)
+
+/**
+ * @brief Filter state (one per encoder, statically allocated by the owner)
+ */
+typedef struct {
+    VFilter_Type type;
+    q16_t output;       // Filtered RPM
+    q16_t accel;        // Acceleration estimate, RPM/s
+    bool primed;        // First sample received
+
+    q16_t alpha;        // IIR / alpha-beta gain
+    q16_t beta;         // Alpha-beta velocity gain
+
+    q16_t window[VFILTER_MEDIAN_WINDOW];
+    uint8_t window_pos;
+    uint8_t window_fill;
+} VFilter;
+
+// ============================================================================
+// Public API Functions
+// ============================================================================
+
+/**
+ * @brief Initialize filter with default coefficients for its type
+ * @param filter Filter state
+ * @param type Filter type
+ */
+void VFilter_Init(VFilter *filter, VFilter_Type type);
+
+/**
+ * @brief Clear filter history (keeps type and coefficients)
+ * @param filter Filter state
+ */
+void VFilter_Reset(VFilter *filter);
+
+/**
+ * @brief Set IIR smoothing factor
+ * @param filter Filter state
+ * @param alpha Q16.16 gain in (0, 1], smaller = smoother
+ */
+void VFilter_SetIIR(VFilter *filter, q16_t alpha);
+
+/**
+ * @brief Set alpha-beta tracker gains
+ * @param filter Filter state
+ * @param alpha Q16.16 speed correction gain in (0, 1]
+ * @param beta Q16.16 acceleration correction gain in (0, 1]
+ */
+void VFilter_SetAlphaBeta(VFilter *filter, q16_t alpha, q16_t beta);
+
+/**
+ * @brief Feed new raw sample
+ * @param filter Filter state
+ * @param sample Raw RPM (Q16.16)
+ * @param dt_us Time since previous sample in microseconds
+ * @return Filtered RPM (Q16.16)
+ */
+q16_t VFilter_Update(VFilter *filter, q16_t sample, uint32_t dt_us);
+
+#endif /* VELOCITY_FILTER_H */
@@ -0,0 +1,124 @@
+/**
+ * @file    isr_stats.c
+ * @brief   Interrupt latency, duration and jitter histograms implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Each IRQ writes only its own entry (an IRQ never preempts itself), so
+ * the handlers need no locking; readers copy under PRIMASK.
+ * The entry-to-entry period is taken from the TIM5 timebase: CYCCNT stops
+ * while the core sleeps in WFI, so a cycle difference across an idle
+ * stretch would come out short. CYCCNT only times the handler itself.
+ */
+
+#include "isr_stats.h"
+
+#ifdef USE_ISR_STATS
+
+#include "speed_control.h"
+#include "timebase.h"
+
+/* Per-interrupt state */
+typedef struct {
+    Isr_Histogram hist[ISR_HIST_COUNT];
+    uint32_t last_entry_us;         // Timebase at the last entry (periodic IRQs)
+    bool last_valid;
+} Isr_Stats;
+
+static const char *const isr_names[ISR_COUNT] = {
+#define ISR_STATS_NAME_(id, name) name,
+    ISR_STATS_LIST(ISR_STATS_NAME_)
+#undef ISR_STATS_NAME_
+};
+
+/* Nominal rate of periodic interrupts, Hz (0 = aperiodic) */
+static const uint32_t isr_rate_hz[ISR_COUNT] = {
+    [ISR_CONTROL] = SPEED_CONTROL_RATE_HZ,
+    [ISR_SYSTICK] = 1000
+};
+
+static Isr_Stats isr_stats[ISR_COUNT];
+static bool isr_timebase_ready;    // SysTick runs before Timebase_Init
+
+/**
+ * @brief Add a value to a histogram
+ */
+static void IsrStats_Add(Isr_Histogram *h, uint32_t value)
+{
+    uint32_t b = (value == 0) ? 0 : 32U - (uint32_t)__builtin_clz(value);
+    if (b >= ISR_STATS_BUCKETS) b = ISR_STATS_BUCKETS - 1;
+
+    h->bucket[b]++;
+    h->count++;
+    if (value > h->max) h->max = value;
+}
+
+void IsrStats_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    IsrStats_Reset();
+    isr_timebase_ready = true;
+}
+
+uint32_t IsrStats_Enter(Isr_ID id)
+{
+    uint32_t now = DWT->CYCCNT;
+    Isr_Stats *s = &isr_stats[id];
+
+    if (isr_rate_hz[id] != 0 && isr_timebase_ready) {
+        uint32_t now_us = Timebase_NowUs();
+        if (s->last_valid) {
+            uint32_t period = now_us - s->last_entry_us;
+            uint32_t nominal = 1000000UL / isr_rate_hz[id];
+            IsrStats_Add(&s->hist[ISR_HIST_JITTER],
+                         (period > nominal) ? period - nominal : nominal - period);
+        }
+        s->last_entry_us = now_us;
+        s->last_valid = true;
+    }
+
+    return now;
+}
+
+uint32_t IsrStats_EnterLatency(Isr_ID id, uint32_t latency_cycles)
+{
+    uint32_t now = IsrStats_Enter(id);
+    IsrStats_Add(&isr_stats[id].hist[ISR_HIST_LATENCY], latency_cycles);
+    return now;
+}
+
+void IsrStats_Exit(Isr_ID id, uint32_t entry)
+{
+    IsrStats_Add(&isr_stats[id].hist[ISR_HIST_DURATION], DWT->CYCCNT - entry);
+}
+
+bool IsrStats_Get(Isr_ID id, Isr_HistKind kind, Isr_Histogram *hist)
+{
+    if (id >= ISR_COUNT || kind >= ISR_HIST_COUNT) return false;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *hist = isr_stats[id].hist[kind];
+    __set_PRIMASK(primask);
+    return true;
+}
+
+const char *IsrStats_GetName(Isr_ID id)
+{
+    if (id >= ISR_COUNT) return "unknown";
+    return isr_names[id];
+}
+
+void IsrStats_Reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8_t i = 0; i < ISR_COUNT; i++) {
+        isr_stats[i] = (Isr_Stats){0};
+    }
+    __set_PRIMASK(primask);
+}
+
+#endif // USE_ISR_STATS
@@ -0,0 +1,72 @@
+/**
+ * @file    mem_stats.c
+ * @brief   Stack high-water mark and RAM usage reporting implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "mem_stats.h"
+#include <malloc.h>
+#include <stddef.h>
+
+/* Linker script symbols */
+extern uint32_t _sdata;
+extern uint32_t _edata;
+extern uint32_t _sbss;
+extern uint32_t _ebss;
+extern uint32_t _estack;
+
+/* newlib: current program break (top of heap) */
+extern void *_sbrk(ptrdiff_t incr);
+
+/* Lowest painted address (words below it belong to the heap) */
+static uint32_t *paint_bottom = NULL;
+
+/**
+ * @brief Current heap top, word aligned
+ */
+static uint32_t *MemStats_HeapTop(void)
+{
+    uintptr_t top = (uintptr_t)_sbrk(0);
+    return (uint32_t *)((top + 3U) & ~(uintptr_t)3U);
+}
+
+void MemStats_PaintStack(void)
+{
+    uint32_t *p = MemStats_HeapTop();
+    uint32_t *end = (uint32_t *)(uintptr_t)(__get_MSP() - MEM_STATS_PAINT_MARGIN);
+
+    paint_bottom = p;
+    while (p < end) {
+        *p++ = MEM_STATS_PAINT;
+    }
+}
+
+void MemStats_Get(MemStats *stats)
+{
+    struct mallinfo mi = mallinfo();
+    uint32_t *stack_top = &_estack;
+
+    stats->ram_total = (uint32_t)((uintptr_t)&_estack - (uintptr_t)&_sdata);
+    stats->data = (uint32_t)((uintptr_t)&_edata - (uintptr_t)&_sdata);
+    stats->bss = (uint32_t)((uintptr_t)&_ebss - (uintptr_t)&_sbss);
+    stats->heap_used = (uint32_t)mi.uordblks;
+    stats->heap_arena = (uint32_t)mi.arena;
+
+    uint32_t *free_start;
+    uint32_t *p;
+    if (paint_bottom != NULL) {
+        /* The heap may have grown over the bottom of the painted area */
+        p = MemStats_HeapTop();
+        if (p < paint_bottom) p = paint_bottom;
+        free_start = p;
+        while (p < stack_top && *p == MEM_STATS_PAINT) p++;
+    } else {
+        /* Not painted: only the current depth is known */
+        free_start = MemStats_HeapTop();
+        p = (uint32_t *)(uintptr_t)__get_MSP();
+    }
+
+    stats->stack_used = (uint32_t)((uintptr_t)stack_top - (uintptr_t)p);
+    stats->stack_free = (uint32_t)((uintptr_t)p - (uintptr_t)free_start);
+}
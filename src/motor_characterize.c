@@ -0,0 +1,283 @@
+/**
+ * @file    motor_characterize.c
+ * @brief   Automated motor characterization sweep implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Sequence per motor: FWD (stop, sweep, stop, step), REV (same), fit, apply.
+ */
+
+#include "motor_characterize.h"
+#include "drivers/sensors/encoder.h"
+#include "speed_control.h"
+#include "autotune.h"
+
+#define MOTOR_CHAR_MS_TO_TICKS(ms)  ((uint32_t)(ms) * SPEED_CONTROL_RATE_HZ / 1000)
+#define MOTOR_CHAR_TICKS_TO_MS(t)   ((uint32_t)(t) * 1000 / SPEED_CONTROL_RATE_HZ)
+
+typedef enum {
+    CHAR_IDLE = 0,
+    CHAR_STOP,              // Coast down, then continue with 'next'
+    CHAR_SWEEP_SETTLE,
+    CHAR_SWEEP_SAMPLE,
+    CHAR_STEP
+} MotorChar_Phase;
+
+/* Run context (shared between main loop and control tick) */
+static struct {
+    volatile MotorChar_Phase phase;
+    MotorChar_Phase next;   // Phase after CHAR_STOP
+    uint8_t pending;        // Motors still to characterize (bit mask)
+    Motor_ID motor;
+    uint8_t dir;            // MOTOR_CHAR_FWD / MOTOR_CHAR_REV
+    uint8_t point;          // Sweep point index
+    uint32_t ticks;         // Ticks in the current phase
+    float sum;
+    uint16_t samples;
+    float sweep[2][MOTOR_CHAR_POINTS];  // Steady-state RPM per duty point
+} mc;
+
+static MotorChar_Calibration calibration[MOTOR_COUNT];
+static volatile uint8_t finished_mask = 0;
+
+/**
+ * @brief Switch phase and restart the phase timer
+ */
+static void MotorChar_Enter(MotorChar_Phase phase)
+{
+    mc.phase = phase;
+    mc.ticks = 0;
+}
+
+static void MotorChar_Drive(uint8_t duty)
+{
+    TB6612FNG_Drive(mc.motor, (mc.dir == MOTOR_CHAR_FWD) ? MOTOR_FORWARD : MOTOR_REVERSE, duty);
+}
+
+/**
+ * @brief Coast down, then go to the given phase
+ */
+static void MotorChar_StopThen(MotorChar_Phase next)
+{
+    TB6612FNG_Stop(mc.motor);
+    mc.next = next;
+    MotorChar_Enter(CHAR_STOP);
+}
+
+/**
+ * @brief Pick the next pending motor or finish the run
+ */
+static void MotorChar_NextMotor(void)
+{
+    for (uint8_t i = 0; i < MOTOR_COUNT; i++) {
+        if (mc.pending & (1U << i)) {
+            mc.pending &= ~(1U << i);
+            mc.motor = (Motor_ID)i;
+            mc.dir = MOTOR_CHAR_FWD;
+            mc.point = 0;
+            MotorChar_StopThen(CHAR_SWEEP_SETTLE);
+            return;
+        }
+    }
+    MotorChar_Enter(CHAR_IDLE);
+}
+
+/**
+ * @brief Least-squares line through the moving sweep points of one direction
+ */
+static bool MotorChar_Fit(const float *rpm, float *slope, float *deadband)
+{
+    float n = 0.0f, sx = 0.0f, sy = 0.0f, sxx = 0.0f, sxy = 0.0f;
+
+    for (uint8_t i = 0; i < MOTOR_CHAR_POINTS; i++) {
+        if (rpm[i] < MOTOR_CHAR_MOVING_RPM) continue;
+        float x = (float)(i * MOTOR_CHAR_DUTY_STEP);
+        n += 1.0f;
+        sx += x;
+        sy += rpm[i];
+        sxx += x * x;
+        sxy += x * rpm[i];
+    }
+
+    float det = n * sxx - sx * sx;
+    if (n < 2.0f || det <= 0.0f) return false;
+
+    float m = (n * sxy - sx * sy) / det;
+    float b = (sy - m * sx) / n;
+    if (m <= 0.0f) return false;
+
+    *slope = m;
+    *deadband = (b < 0.0f) ? -b / m : 0.0f;
+    return true;
+}
+
+/**
+ * @brief Build the calibration table and hand it to the speed controller
+ */
+static void MotorChar_Finish(void)
+{
+    MotorChar_Calibration *cal = &calibration[mc.motor];
+
+    bool ok = true;
+    for (uint8_t d = 0; d < 2; d++) {
+        ok &= MotorChar_Fit(mc.sweep[d], &cal->slope[d], &cal->deadband[d]);
+        cal->max_rpm[d] = mc.sweep[d][MOTOR_CHAR_POINTS - 1];
+    }
+    cal->valid = ok;
+
+    if (ok) {
+        float mean_slope = 0.5f * (cal->slope[MOTOR_CHAR_FWD] + cal->slope[MOTOR_CHAR_REV]);
+        cal->asymmetry = 100.0f * (cal->slope[MOTOR_CHAR_FWD] - cal->slope[MOTOR_CHAR_REV]) /
+                         mean_slope;
+
+        /* Feed-forward per direction: duty = rpm / slope + deadband */
+        SpeedControl_Gains gains;
+        SpeedControl_GetGains(mc.motor, &gains);
+        for (uint8_t d = 0; d < 2; d++) {
+            gains.kff[d] = 1.0f / cal->slope[d];
+            gains.deadband[d] = cal->deadband[d];
+        }
+        SpeedControl_SetGains(mc.motor, &gains);
+    }
+
+    finished_mask |= (uint8_t)(1U << mc.motor);
+}
+
+/**
+ * @brief Start characterization
+ */
+bool MotorChar_Start(uint8_t motor_mask)
+{
+    motor_mask &= (1U << MOTOR_COUNT) - 1;
+    if (motor_mask == 0 || MotorChar_IsRunning() || Autotune_IsRunning()) {
+        return false;
+    }
+
+    SpeedControl_DisableAll();
+    TB6612FNG_StopAll();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    mc.pending = motor_mask;
+    finished_mask = 0;
+    MotorChar_NextMotor();
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+void MotorChar_Abort(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (MotorChar_IsRunning()) {
+        TB6612FNG_Stop(mc.motor);
+        mc.pending = 0;
+        MotorChar_Enter(CHAR_IDLE);
+    }
+    __set_PRIMASK(primask);
+}
+
+bool MotorChar_IsRunning(void)
+{
+    return mc.phase != CHAR_IDLE;
+}
+
+bool MotorChar_IsTesting(Motor_ID motor)
+{
+    return MotorChar_IsRunning() && (mc.motor == motor || (mc.pending & (1U << motor)));
+}
+
+const MotorChar_Calibration *MotorChar_GetCalibration(Motor_ID motor)
+{
+    if (motor >= MOTOR_COUNT) return NULL;
+    return &calibration[motor];
+}
+
+bool MotorChar_PollResult(Motor_ID *motor)
+{
+    uint8_t mask = finished_mask;
+    if (mask == 0) return false;
+
+    for (uint8_t i = 0; i < MOTOR_COUNT; i++) {
+        if (mask & (1U << i)) {
+            uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            finished_mask &= ~(1U << i);
+            __set_PRIMASK(primask);
+            *motor = (Motor_ID)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Characterization step at the control rate
+ */
+void MotorChar_Tick(void)
+{
+    if (mc.phase == CHAR_IDLE) return;
+
+    float rpm = Encoder_GetRPM((Encoder_ID)mc.motor);
+    mc.ticks++;
+
+    switch (mc.phase) {
+        case CHAR_STOP:
+            /* Wheel must be still; give up waiting after 3x the coast time */
+            if (mc.ticks >= MOTOR_CHAR_MS_TO_TICKS(MOTOR_CHAR_STOP_MS) &&
+                (rpm < MOTOR_CHAR_MOVING_RPM ||
+                 mc.ticks >= MOTOR_CHAR_MS_TO_TICKS(3 * MOTOR_CHAR_STOP_MS))) {
+                MotorChar_Enter(mc.next);
+            }
+            break;
+
+        case CHAR_SWEEP_SETTLE:
+            MotorChar_Drive(mc.point * MOTOR_CHAR_DUTY_STEP);
+            if (mc.ticks >= MOTOR_CHAR_MS_TO_TICKS(MOTOR_CHAR_SETTLE_MS)) {
+                mc.sum = 0.0f;
+                mc.samples = 0;
+                MotorChar_Enter(CHAR_SWEEP_SAMPLE);
+            }
+            break;
+
+        case CHAR_SWEEP_SAMPLE:
+            mc.sum += rpm;
+            mc.samples++;
+            if (mc.ticks >= MOTOR_CHAR_MS_TO_TICKS(MOTOR_CHAR_SAMPLE_MS)) {
+                mc.sweep[mc.dir][mc.point] = mc.sum / mc.samples;
+                if (++mc.point < MOTOR_CHAR_POINTS) {
+                    MotorChar_Enter(CHAR_SWEEP_SETTLE);
+                } else {
+                    MotorChar_StopThen(CHAR_STEP);
+                }
+            }
+            break;
+
+        case CHAR_STEP: {
+            float target = 0.632f * mc.sweep[mc.dir][MOTOR_CHAR_STEP_DUTY / MOTOR_CHAR_DUTY_STEP];
+            bool reached = (target >= MOTOR_CHAR_MOVING_RPM) && (rpm >= target);
+            bool timeout = mc.ticks >= MOTOR_CHAR_MS_TO_TICKS(MOTOR_CHAR_STEP_TIMEOUT_MS);
+
+            MotorChar_Drive(MOTOR_CHAR_STEP_DUTY);
+            if (!reached && !timeout) break;
+
+            calibration[mc.motor].tau_ms[mc.dir] =
+                reached ? (uint16_t)MOTOR_CHAR_TICKS_TO_MS(mc.ticks) : 0;
+
+            if (mc.dir == MOTOR_CHAR_FWD) {
+                mc.dir = MOTOR_CHAR_REV;
+                mc.point = 0;
+                MotorChar_StopThen(CHAR_SWEEP_SETTLE);
+            } else {
+                TB6612FNG_Stop(mc.motor);
+                MotorChar_Finish();
+                MotorChar_NextMotor();
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file    motor_characterize.h
+ * @brief   Automated motor characterization sweep (measured, non-blocking)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * For each selected motor and both directions:
+ *   1. Duty sweep 0..100 % in MOTOR_CHAR_DUTY_STEP, steady-state RPM per step
+ *   2. Step response 0 -> MOTOR_CHAR_STEP_DUTY, time constant (63.2 % rise)
+ * A least-squares line RPM = slope * (duty - deadband) through the moving
+ * points gives the calibration consumed by the speed controller, per
+ * direction (kff[dir] = 1 / slope, deadband[dir]). Stepped from the control
+ * tick, so the main loop keeps running (no HAL_Delay).
+ */
+
+#ifndef MOTOR_CHARACTERIZE_H
+#define MOTOR_CHARACTERIZE_H
+
+#include "main.h"
+#include "drivers/motor/tb6612fng.h"
+#include "speed_control.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Sweep parameters */
+#define MOTOR_CHAR_DUTY_STEP        5       // Duty increment, %
+#define MOTOR_CHAR_POINTS           (100 / MOTOR_CHAR_DUTY_STEP + 1)
+#define MOTOR_CHAR_SETTLE_MS        600     // Wait after each duty change
+#define MOTOR_CHAR_SAMPLE_MS        200     // RPM averaging window
+#define MOTOR_CHAR_STOP_MS          1500    // Coast-down before each test
+#define MOTOR_CHAR_STEP_DUTY        60      // Step response amplitude, %
+#define MOTOR_CHAR_STEP_TIMEOUT_MS  2000    // Give up on the 63.2 % point
+#define MOTOR_CHAR_MOVING_RPM       5.0f    // Below this the wheel is stalled
+
+/* Direction index in the calibration arrays */
+#define MOTOR_CHAR_FWD              SPEED_CONTROL_FWD
+#define MOTOR_CHAR_REV              SPEED_CONTROL_REV
+
+/* Calibration table for one motor */
+typedef struct {
+    bool valid;
+    float deadband[2];      // Duty % where the fitted line crosses 0 RPM
+    float slope[2];         // RPM per duty % above the deadband
+    float max_rpm[2];       // RPM at 100 %
+    uint16_t tau_ms[2];     // Step response time constant (0 = not reached)
+    float asymmetry;        // (fwd - rev) / mean slope, %
+} MotorChar_Calibration;
+
+/**
+ * @brief Start characterization
+ * @param motor_mask Bit per motor (bit 0 = MOTOR_0), 0x0F = all
+ * @return true if started (nothing else driving the motors open loop)
+ */
+bool MotorChar_Start(uint8_t motor_mask);
+
+/**
+ * @brief Abort characterization and stop the motor under test
+ */
+void MotorChar_Abort(void);
+
+/**
+ * @brief Check if a characterization is in progress
+ */
+bool MotorChar_IsRunning(void);
+
+/**
+ * @brief Check if a motor is under test or still queued in the running sweep
+ * @param motor Motor ID
+ */
+bool MotorChar_IsTesting(Motor_ID motor);
+
+/**
+ * @brief Get calibration of a motor
+ * @param motor Motor ID
+ * @return Calibration (valid = false until characterized)
+ */
+const MotorChar_Calibration *MotorChar_GetCalibration(Motor_ID motor);
+
+/**
+ * @brief Fetch next motor finished since the last call
+ * @param motor Output: characterized motor
+ * @return true if a motor finished (its calibration is already applied)
+ */
+bool MotorChar_PollResult(Motor_ID *motor);
+
+/**
+ * @brief Characterization step (called from SpeedControl_Tick)
+ */
+void MotorChar_Tick(void);
+
+#endif /* MOTOR_CHARACTERIZE_H */
@@ -0,0 +1,155 @@
+/**
+ * @file    odometry.c
+ * @brief   Wheel odometry implementation (fixed point)
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Internal units: position in micrometers, heading as a 32-bit binary
+ * angle (2^32 = 360 degrees, wraps naturally).
+ */
+
+#include "odometry.h"
+#include "drivers/motor/tb6612fng.h"
+#include "drivers/sensors/encoder.h"
+
+/* Wheel travel per encoder slot, um (pi * D / slots) */
+#define ODOM_UM_PER_COUNT \
+    ((int32_t)(3141593UL * ODOMETRY_WHEEL_DIAMETER_MM / (1000UL * ENCODER_SLOTS_PER_REV)))
+
+/* Circumference of the turning circle (2 * pi * track), um */
+#define ODOM_TRACK_CIRC_UM \
+    ((int64_t)6283185 * ODOMETRY_TRACK_WIDTH_MM / 1000)
+
+/* Quarter-wave sine table, Q15, 64 segments */
+static const int16_t sin_table[65] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767,
+};
+
+/* Pose state */
+static int32_t  pose_x_um = 0;
+static int32_t  pose_y_um = 0;
+static uint32_t pose_heading = 0;
+
+/* Encoder counts at previous update and last driven direction per wheel */
+static uint32_t last_count[MOTOR_COUNT] = {0};
+static Motor_Direction last_dir[MOTOR_COUNT] = {
+    MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_FORWARD, MOTOR_FORWARD
+};
+
+/**
+ * @brief Sine of a binary angle, Q15 (linear interpolation in table)
+ */
+static int32_t SinQ15(uint32_t angle)
+{
+    uint32_t quadrant = angle >> 30;
+    uint32_t pos = (angle >> 14) & 0xFFFF;   // Position inside quadrant, 16 bit
+
+    if (quadrant & 1) {
+        pos = 0x10000 - pos;
+    }
+
+    uint32_t idx = pos >> 10;
+    uint32_t frac = pos & 0x3FF;
+    int32_t value = sin_table[idx];
+    if (idx < 64) {
+        value += ((sin_table[idx + 1] - value) * (int32_t)frac) >> 10;
+    }
+
+    return (quadrant >= 2) ? -value : value;
+}
+
+static int32_t CosQ15(uint32_t angle)
+{
+    return SinQ15(angle + 0x40000000UL);
+}
+
+/**
+ * @brief Signed travel of one wheel since previous update, um
+ * @note Encoders are single-channel: sign comes from the driven direction.
+ *       While coasting/braking the last driven direction is kept.
+ */
+static int32_t WheelTravel(Motor_ID motor)
+{
+    uint32_t count = Encoder_GetCount((Encoder_ID)motor);
+    int32_t delta = (int32_t)(count - last_count[motor]);
+    last_count[motor] = count;
+
+    Motor_Direction dir = TB6612FNG_GetDirection(motor);
+    if (dir == MOTOR_FORWARD || dir == MOTOR_REVERSE) {
+        last_dir[motor] = dir;
+    }
+
+    if (last_dir[motor] == MOTOR_REVERSE) {
+        delta = -delta;
+    }
+    return delta * ODOM_UM_PER_COUNT;
+}
+
+/**
+ * @brief Initialize odometry
+ */
+void Odometry_Init(void)
+{
+    Odometry_Reset();
+}
+
+/**
+ * @brief Reset pose and re-latch encoder counts
+ */
+void Odometry_Reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    for (uint8_t i = 0; i < MOTOR_COUNT; i++) {
+        last_count[i] = Encoder_GetCount((Encoder_ID)i);
+    }
+    pose_x_um = 0;
+    pose_y_um = 0;
+    pose_heading = 0;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Integrate wheel travel (midpoint heading)
+ */
+void Odometry_Update(void)
+{
+    int32_t left  = (WheelTravel(MOTOR_0) + WheelTravel(MOTOR_1)) / 2;
+    int32_t right = (WheelTravel(MOTOR_2) + WheelTravel(MOTOR_3)) / 2;
+
+    int32_t center = (left + right) / 2;
+    // 2^32 = full turn; multiply, not <<: left turns make the difference negative
+    int32_t dtheta = (int32_t)(((int64_t)(right - left) * ((int64_t)1 << 32)) / ODOM_TRACK_CIRC_UM);
+
+    uint32_t mid = pose_heading + (uint32_t)(dtheta / 2);
+    pose_x_um += (int32_t)(((int64_t)center * CosQ15(mid)) >> 15);
+    pose_y_um += (int32_t)(((int64_t)center * SinQ15(mid)) >> 15);
+    pose_heading += (uint32_t)dtheta;
+}
+
+/**
+ * @brief Get current pose in mm / 0.01 degree
+ */
+void Odometry_GetPose(Odometry_Pose *pose)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    int32_t x = pose_x_um;
+    int32_t y = pose_y_um;
+    uint32_t heading = pose_heading;
+    __set_PRIMASK(primask);
+
+    pose->x_mm = x / 1000;
+    pose->y_mm = y / 1000;
+    pose->heading_cdeg = (int32_t)(((int64_t)(int32_t)heading * 36000) >> 32);
+}
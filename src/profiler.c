@@ -0,0 +1,102 @@
+/**
+ * @file    profiler.c
+ * @brief   DWT cycle-counter profiling implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "profiler.h"
+
+#ifdef USE_PROFILER
+
+#if !defined(__arm__)
+#include <time.h>
+#endif
+
+static const char *const region_names[PROFILE_COUNT] = {
+#define PROFILER_NAME_(id, name) name,
+    PROFILER_REGIONS(PROFILER_NAME_)
+#undef PROFILER_NAME_
+};
+
+static Profiler_Stats stats_table[PROFILE_COUNT];
+
+#if defined(__arm__)
+
+/* Critical section: regions may be recorded from ISRs and the main loop */
+#define PROFILER_LOCK()     uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define PROFILER_UNLOCK()   __set_PRIMASK(primask)
+
+uint32_t Profiler_CyclesPerUs(void)
+{
+    return SystemCoreClock / 1000000UL;
+}
+
+#else
+
+/* Host stub: monotonic clock in ns, no interrupts to mask */
+#define PROFILER_LOCK()     do { } while (0)
+#define PROFILER_UNLOCK()   do { } while (0)
+
+uint32_t Profiler_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t Profiler_CyclesPerUs(void)
+{
+    return 1000;
+}
+
+#endif
+
+void Profiler_Init(void)
+{
+    #if defined(__arm__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+
+    Profiler_Reset();
+}
+
+void Profiler_Record(Profiler_Region region, uint32_t cycles)
+{
+    if (region >= PROFILE_COUNT) return;
+
+    Profiler_Stats *s = &stats_table[region];
+
+    PROFILER_LOCK();
+    s->count++;
+    s->total += cycles;
+    if (cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    PROFILER_UNLOCK();
+}
+
+bool Profiler_GetStats(Profiler_Region region, Profiler_Stats *stats)
+{
+    if (region >= PROFILE_COUNT) return false;
+
+    PROFILER_LOCK();
+    *stats = stats_table[region];
+    PROFILER_UNLOCK();
+
+    if (stats->count == 0) stats->min = 0;
+    return true;
+}
+
+void Profiler_Reset(void)
+{
+    for (uint8_t i = 0; i < PROFILE_COUNT; i++) {
+        PROFILER_LOCK();
+        stats_table[i] = (Profiler_Stats){0};
+        stats_table[i].name = region_names[i];
+        stats_table[i].min = UINT32_MAX;
+        PROFILER_UNLOCK();
+    }
+}
+
+#endif // USE_PROFILER
@@ -0,0 +1,148 @@
+/**
+ * @file    recorder.c
+ * @brief   Session recorder implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "recorder.h"
+
+#ifdef USE_RECORDER
+
+#include "timebase.h"
+
+static uint8_t rec_buffer[RECORDER_BUFFER_SIZE];
+static volatile uint32_t rec_head = 0;         // Bytes written
+static volatile uint32_t rec_tail = 0;         // Start of the oldest record
+static volatile uint32_t rec_lost = 0;         // Records overwritten
+static volatile bool rec_frozen = false;       // Dump in progress
+
+/* Telemetry line being assembled */
+static char out_line[RECORDER_MAX_LINE];
+static uint16_t out_len = 0;
+static uint32_t out_time = 0;                  // First byte of the line
+
+#define REC_AT(i)   rec_buffer[(i) & (RECORDER_BUFFER_SIZE - 1)]
+
+static void Recorder_Store(Recorder_Dir dir, uint32_t time_us, const char *line, uint16_t len)
+{
+    if (len > RECORDER_MAX_LINE) len = RECORDER_MAX_LINE;
+    uint32_t size = RECORDER_HEADER_SIZE + len;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (rec_frozen) {
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    /* Make room: drop the oldest records */
+    while (RECORDER_BUFFER_SIZE - (rec_head - rec_tail) < size) {
+        rec_tail += RECORDER_HEADER_SIZE + REC_AT(rec_tail + 5);
+        rec_lost++;
+    }
+
+    uint32_t head = rec_head;
+    REC_AT(head++) = (uint8_t)time_us;
+    REC_AT(head++) = (uint8_t)(time_us >> 8);
+    REC_AT(head++) = (uint8_t)(time_us >> 16);
+    REC_AT(head++) = (uint8_t)(time_us >> 24);
+    REC_AT(head++) = (uint8_t)dir;
+    REC_AT(head++) = (uint8_t)len;
+    for (uint16_t i = 0; i < len; i++) {
+        REC_AT(head++) = (uint8_t)line[i];
+    }
+    rec_head = head;
+    __set_PRIMASK(primask);
+}
+
+void Recorder_Init(void)
+{
+    Recorder_Clear();
+}
+
+void Recorder_Input(const char *line, uint16_t len)
+{
+    Recorder_Store(RECORDER_IN, Timebase_NowUs(), line, len);
+}
+
+void Recorder_Output(const char *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        if (out_len == 0) out_time = Timebase_NowUs();
+        if (data[i] == '\n') {
+            Recorder_Store(RECORDER_OUT, out_time, out_line, out_len);
+            out_len = 0;
+        } else if (out_len < RECORDER_MAX_LINE) {
+            out_line[out_len++] = data[i];
+        }
+    }
+}
+
+void Recorder_Clear(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    rec_head = 0;
+    rec_tail = 0;
+    rec_lost = 0;
+    rec_frozen = false;
+    __set_PRIMASK(primask);
+}
+
+uint16_t Recorder_Read(uint8_t *out, uint16_t max)
+{
+    uint16_t n = 0;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t tail = rec_tail;
+    while (tail != rec_head) {
+        uint16_t size = RECORDER_HEADER_SIZE + REC_AT(tail + 5);
+        if (n + size > max) break;
+        for (uint16_t i = 0; i < size; i++) {
+            out[n++] = REC_AT(tail++);
+        }
+    }
+    rec_tail = tail;
+    __set_PRIMASK(primask);
+    return n;
+}
+
+uint32_t Recorder_GetLost(void)
+{
+    return rec_lost;
+}
+
+uint32_t Recorder_BeginDump(uint32_t *lost)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    rec_frozen = true;
+    if (lost != NULL) *lost = rec_lost;
+    uint32_t bytes = rec_head - rec_tail;
+    __set_PRIMASK(primask);
+    return bytes;
+}
+
+uint16_t Recorder_ReadDump(uint8_t *out, uint16_t max)
+{
+    if (!rec_frozen) return 0;
+
+    /* Frozen: nothing writes, plain byte copy */
+    uint16_t n = 0;
+    while (n < max && rec_tail != rec_head) {
+        out[n++] = REC_AT(rec_tail);
+        rec_tail++;
+    }
+
+    if (n == 0) Recorder_Clear();
+    return n;
+}
+
+bool Recorder_IsDumping(void)
+{
+    return rec_frozen;
+}
+
+#endif // USE_RECORDER
@@ -0,0 +1,453 @@
+/**
+ * @file    remote_command.c
+ * @brief   UART command interface (from ESP32) implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "remote_command.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "drivers/motor/tb6612fng.h"
+#include "drivers/sensors/encoder.h"
+#include "button_control.h"
+#include "odometry.h"
+#include "speed_control.h"
+#include "autotune.h"
+#include "motor_characterize.h"
+#include "wheel_sync.h"
+#include "scheduler.h"
+#include "clock_profile.h"
+#include "profiler.h"
+#include "isr_stats.h"
+#include "mem_stats.h"
+#include "trace.h"
+#include "bench.h"
+#include "recorder.h"
+#ifdef USE_UART_TELEMETRY
+#include "uart_telemetry.h"
+#endif
+
+/* Line assembly in the RX interrupt, one byte at a time */
+static uint8_t           rx_byte;
+static char              rx_buf[REMOTE_COMMAND_MAX_LEN];
+static uint8_t           rx_pos = 0;
+static volatile uint8_t  cmd_ready = 0;
+static char              cmd_buf[REMOTE_COMMAND_MAX_LEN];
+static int8_t            notify_task = -1;     // Woken by the RX callback
+static volatile uint32_t lines_received = 0;
+static volatile uint32_t lines_dropped = 0;    // Previous command not consumed yet
+
+void RemoteCommand_Start(int8_t task)
+{
+    notify_task = task;
+    rx_pos = 0;
+    cmd_ready = 0;
+
+    #ifdef USE_UART_TELEMETRY
+    // Start interrupt-based RX (re-armed in callback after each byte)
+    HAL_UART_Receive_IT(&huart1, &rx_byte, 1);
+    #endif
+}
+
+bool RemoteCommand_ReceiveByte(char c)
+{
+    bool queued = false;
+
+    if (c == '\n' || rx_pos >= REMOTE_COMMAND_MAX_LEN - 2)
+    {
+        rx_buf[rx_pos] = '\0';
+        rx_pos = 0;
+        if (rx_buf[0] != '\0')
+        {
+            lines_received++;
+            RECORDER_INPUT(rx_buf, (uint16_t)strlen(rx_buf));
+            // Only copy to dispatch buffer if previous command was already consumed
+            if (cmd_ready)
+            {
+                lines_dropped++;
+            }
+            else
+            {
+                uint8_t i = 0;
+                while (rx_buf[i] && i < REMOTE_COMMAND_MAX_LEN - 1) { cmd_buf[i] = rx_buf[i]; i++; }
+                cmd_buf[i] = '\0';
+                cmd_ready = 1;
+                TRACE(UART_RX, i, 0);
+                queued = true;
+            }
+        }
+    }
+    else if (c != '\r')
+    {
+        rx_buf[rx_pos++] = c;
+    }
+
+    return queued;
+}
+
+/**
+ * @brief Dispatch the command assembled in the RX interrupt
+ * Budget covers the blocking telemetry reply
+ */
+void RemoteCommand_Process(void)
+{
+    if (cmd_ready)
+    {
+        PROFILE_BEGIN(COMMAND);
+        TRACE(COMMAND, cmd_buf[2], 0);
+        RemoteCommand_Execute(cmd_buf);
+        PROFILE_END(COMMAND);
+        cmd_ready = 0;
+    }
+}
+
+/**
+ * @brief Parse and execute one command line
+ * Format: "C:F:70" = forward 70%, "C:B:70" = backward, "C:L:70" = left,
+ *         "C:R:70" = right, "C:S" = stop, "C:M:0:F:70" = motor 0 fwd 70%,
+ *         "C:E" = encoder status (RPM + rejected glitches),
+ *         "C:P" = odometry pose, "C:P:R" = reset pose to origin,
+ *         "C:V:0:120" = motor 0 closed loop at 120 RPM ("C:V:A:-80" = all
+ *         motors, negative = reverse, 0 = hold stopped),
+ *         "C:K:0:100:500:0[:150]" = motor 0 gains kp:ki:kd[:kff] in 1/1000
+ *         (kff for both directions),
+ *         "C:T:0:120[:20[:1]]" = relay auto-tune motor 0 around 120 RPM
+ *         (relay amplitude %, default 35; rule 0 = PI / 1 = PID), "C:T:S" = abort,
+ *         "C:X:0" = characterize motor 0 ("C:X:A" = all), "C:X:S" = abort,
+ *         "C:D:150:150" = synchronized drive left:right RPM (straight),
+ *         "C:D:-100:100" = rotate left with equal wheel travel, "C:D:0:0" = stop,
+ *         "C:J" = scheduler task statistics, "C:J:R" = reset statistics,
+ *         "C:I" = idle time and command wake-up latency,
+ *         "C:Z" = clock profile, "C:Z:2" = switch to profile 2
+ *         (0 = performance 100 MHz, 1 = balanced 96 MHz, 2 = economy 48 MHz),
+ *         "C:Q" = profiler region statistics, "C:Q:R" = reset (USE_PROFILER),
+ *         "C:H" = interrupt latency/duration/jitter histograms, "C:H:R" = reset
+ *         (USE_ISR_STATS),
+ *         "C:U" = RAM usage (static, heap, stack high-water mark),
+ *         "C:Y" = dump event trace, "C:Y:C" = clear (USE_TRACE),
+ *         "C:W" = run the benchmark suite (USE_BENCH, stalls ~1 s, motors stop),
+ *         "C:G" = dump recorded session, "C:G:C" = clear (USE_RECORDER)
+ * Manual commands (F/B/L/R/S/M) switch the closed loop off and abort an
+ * auto-tune or characterization that drives the same motor; C:V and C:D
+ * abort both experiments before closing the loop.
+ */
+void RemoteCommand_Execute(const char *cmd)
+{
+    if (strncmp(cmd, "C:", 2) != 0) return;
+
+    char action = cmd[2];
+    int speed = 70;
+
+    // Аргументи лише після "C:x:"; для "C:x" - порожній рядок, а не залишки
+    // попередньої команди, що лишаються в cmd_buf за новим '\0'
+    const char *args = (action != '\0' && cmd[3] == ':') ? cmd + 4 : "";
+
+    if (action == 'F') {
+        SpeedControl_DisableAll();
+        sscanf(args, "%d", &speed);
+        TB6612FNG_MoveForward((uint8_t)speed);
+        for (uint8_t i = 0; i < 4; i++) ButtonControl_LED_On(i);
+        #ifdef USE_UART_TELEMETRY
+        Telemetry_SendMotor(0, MOTOR_FORWARD, (uint8_t)speed);
+        Telemetry_SendMotor(1, MOTOR_FORWARD, (uint8_t)speed);
+        Telemetry_SendMotor(2, MOTOR_FORWARD, (uint8_t)speed);
+        Telemetry_SendMotor(3, MOTOR_FORWARD, (uint8_t)speed);
+        #endif
+    } else if (action == 'B') {
+        SpeedControl_DisableAll();
+        sscanf(args, "%d", &speed);
+        TB6612FNG_MoveBackward((uint8_t)speed);
+        for (uint8_t i = 0; i < 4; i++) ButtonControl_LED_On(i);
+        #ifdef USE_UART_TELEMETRY
+        Telemetry_SendMotor(0, MOTOR_REVERSE, (uint8_t)speed);
+        Telemetry_SendMotor(1, MOTOR_REVERSE, (uint8_t)speed);
+        Telemetry_SendMotor(2, MOTOR_REVERSE, (uint8_t)speed);
+        Telemetry_SendMotor(3, MOTOR_REVERSE, (uint8_t)speed);
+        #endif
+    } else if (action == 'L') {
+        SpeedControl_DisableAll();
+        sscanf(args, "%d", &speed);
+        TB6612FNG_RotateLeft((uint8_t)speed);
+        ButtonControl_LED_On(0);  ButtonControl_LED_On(1);
+        ButtonControl_LED_Off(2); ButtonControl_LED_Off(3);
+        #ifdef USE_UART_TELEMETRY
+        Telemetry_SendMotor(0, MOTOR_REVERSE, (uint8_t)speed);
+        Telemetry_SendMotor(1, MOTOR_REVERSE, (uint8_t)speed);
+        Telemetry_SendMotor(2, MOTOR_FORWARD, (uint8_t)speed);
+        Telemetry_SendMotor(3, MOTOR_FORWARD, (uint8_t)speed);
+        #endif
+    } else if (action == 'R') {
+        SpeedControl_DisableAll();
+        sscanf(args, "%d", &speed);
+        TB6612FNG_RotateRight((uint8_t)speed);
+        ButtonControl_LED_Off(0); ButtonControl_LED_Off(1);
+        ButtonControl_LED_On(2);  ButtonControl_LED_On(3);
+        #ifdef USE_UART_TELEMETRY
+        Telemetry_SendMotor(0, MOTOR_FORWARD, (uint8_t)speed);
+        Telemetry_SendMotor(1, MOTOR_FORWARD, (uint8_t)speed);
+        Telemetry_SendMotor(2, MOTOR_REVERSE, (uint8_t)speed);
+        Telemetry_SendMotor(3, MOTOR_REVERSE, (uint8_t)speed);
+        #endif
+    } else if (action == 'S') {
+        SpeedControl_DisableAll();
+        TB6612FNG_StopAll();
+        for (uint8_t i = 0; i < 4; i++) ButtonControl_LED_Off(i);
+        #ifdef USE_UART_TELEMETRY
+        Telemetry_SendMotor(0, MOTOR_STOP, 0);
+        Telemetry_SendMotor(1, MOTOR_STOP, 0);
+        Telemetry_SendMotor(2, MOTOR_STOP, 0);
+        Telemetry_SendMotor(3, MOTOR_STOP, 0);
+        #endif
+    } else if (action == 'M') {
+        int motor_id; char dir_c;
+        if (sscanf(args, "%d:%c:%d", &motor_id, &dir_c, &speed) == 3 &&
+            motor_id >= 0 && motor_id < MOTOR_COUNT) {
+            Motor_Direction dir = (dir_c == 'F') ? MOTOR_FORWARD :
+                                  (dir_c == 'B') ? MOTOR_REVERSE : MOTOR_STOP;
+            if (Autotune_IsTesting((Motor_ID)motor_id)) Autotune_Abort();
+            if (MotorChar_IsTesting((Motor_ID)motor_id)) MotorChar_Abort();
+            SpeedControl_Disable((Motor_ID)motor_id);
+            TB6612FNG_Drive((Motor_ID)motor_id, dir, (uint8_t)speed);
+            if (dir == MOTOR_STOP)
+                ButtonControl_LED_Off((uint8_t)motor_id);
+            else
+                ButtonControl_LED_On((uint8_t)motor_id);
+            #ifdef USE_UART_TELEMETRY
+            Telemetry_SendMotor((uint8_t)motor_id, (uint8_t)dir, (uint8_t)speed);
+            #endif
+        }
+    } else if (action == 'E') {
+        #ifdef USE_UART_TELEMETRY
+        for (uint8_t i = 0; i < ENCODER_COUNT; i++) {
+            Telemetry_SendEncoder(i, Encoder_GetRPM((Encoder_ID)i),
+                                  Encoder_GetGlitchCount((Encoder_ID)i));
+        }
+        #endif
+    } else if (action == 'P') {
+        if (args[0] == 'R') {
+            Odometry_Reset();
+        }
+        RemoteCommand_SendPose();
+    } else if (action == 'V') {
+        char target;
+        int rpm;
+        if (sscanf(args, "%c:%d", &target, &rpm) != 2) return;
+        uint8_t first = 0, last = MOTOR_COUNT - 1;
+        if (target != 'A') {
+            if (target < '0' || target >= '0' + MOTOR_COUNT) return;
+            first = last = (uint8_t)(target - '0');
+        }
+        WheelSync_Disable();
+        Autotune_Abort();
+        MotorChar_Abort();
+        for (uint8_t i = first; i <= last; i++) {
+            SpeedControl_SetRPM((Motor_ID)i, (float)rpm);
+            if (rpm != 0)
+                ButtonControl_LED_On(i);
+            else
+                ButtonControl_LED_Off(i);
+            #ifdef USE_UART_TELEMETRY
+            Telemetry_SendSpeed(i, (float)rpm, Encoder_GetRPM((Encoder_ID)i),
+                                SpeedControl_GetOutput((Motor_ID)i));
+            #endif
+        }
+    } else if (action == 'K') {
+        int motor_id, kp, ki, kd, kff;
+        int n = sscanf(args, "%d:%d:%d:%d:%d", &motor_id, &kp, &ki, &kd, &kff);
+        if (n < 4 || motor_id < 0 || motor_id >= MOTOR_COUNT) return;
+        SpeedControl_Gains gains;
+        SpeedControl_GetGains((Motor_ID)motor_id, &gains);
+        gains.kp = kp / 1000.0f;
+        gains.ki = ki / 1000.0f;
+        gains.kd = kd / 1000.0f;
+        if (n == 5) gains.kff[SPEED_CONTROL_FWD] = gains.kff[SPEED_CONTROL_REV] = kff / 1000.0f;
+        SpeedControl_SetGains((Motor_ID)motor_id, &gains);
+    } else if (action == 'T') {
+        if (args[0] == 'S') {
+            Autotune_Abort();
+            return;
+        }
+        int motor_id, rpm, relay = 0, rule = AUTOTUNE_RULE_PI;
+        if (sscanf(args, "%d:%d:%d:%d", &motor_id, &rpm, &relay, &rule) < 2) return;
+        if (motor_id < 0 || motor_id >= MOTOR_COUNT || rpm == 0 ||
+            relay < 0 || relay > 100 || (rule != AUTOTUNE_RULE_PI && rule != AUTOTUNE_RULE_PID)) {
+            return;
+        }
+        WheelSync_Disable();
+        if (Autotune_Start((Motor_ID)motor_id, (float)rpm, (uint8_t)relay,
+                           rule ? AUTOTUNE_RULE_PID : AUTOTUNE_RULE_PI)) {
+            ButtonControl_LED_On((uint8_t)motor_id);
+        }
+    } else if (action == 'X') {
+        if (args[0] == 'S') {
+            MotorChar_Abort();
+            return;
+        }
+        if (args[0] == '\0' || args[1] != '\0') return;
+        if (args[0] != 'A' && (args[0] < '0' || args[0] >= '0' + MOTOR_COUNT)) return;
+        MotorChar_Start((args[0] == 'A') ? 0x0F : (uint8_t)(1U << (args[0] - '0')));
+    } else if (action == 'D') {
+        int left, right;
+        if (sscanf(args, "%d:%d", &left, &right) != 2) return;
+        Autotune_Abort();
+        MotorChar_Abort();
+        WheelSync_Drive((float)left, (float)right);
+        for (uint8_t i = 0; i < MOTOR_COUNT; i++) {
+            if (left != 0 || right != 0)
+                ButtonControl_LED_On(i);
+            else
+                ButtonControl_LED_Off(i);
+            #ifdef USE_UART_TELEMETRY
+            Telemetry_SendSpeed(i, SpeedControl_GetSetpoint((Motor_ID)i),
+                                Encoder_GetRPM((Encoder_ID)i),
+                                SpeedControl_GetOutput((Motor_ID)i));
+            #endif
+        }
+    } else if (action == 'J') {
+        if (args[0] == 'R') {
+            Scheduler_ResetStats();
+            return;
+        }
+        #ifdef USE_UART_TELEMETRY
+        Scheduler_TaskStats st;
+        for (uint8_t i = 0; Scheduler_GetStats(i, &st); i++) {
+            uint32_t avg = st.runs ? (uint32_t)(st.total_us / st.runs) : 0;
+            Telemetry_SendTask(i, st.name, st.runs, avg, st.max_us, st.overruns, st.missed);
+        }
+        #endif
+    } else if (action == 'I') {
+        #ifdef USE_UART_TELEMETRY
+        Scheduler_IdleStats idle;
+        Scheduler_GetIdleStats(&idle);
+        Telemetry_SendIdle(idle.idle_percent, idle.sleeps, idle.wake_latency_max_us,
+                           idle.latency_violations);
+        #endif
+    } else if (action == 'Z') {
+        if (args[0] != '\0') {
+            int profile = 0;
+            if (sscanf(args, "%d", &profile) != 1 ||
+                !ClockProfile_Set((Clock_Profile)profile)) {
+                return;
+            }
+        }
+        #ifdef USE_UART_TELEMETRY
+        Telemetry_SendClock(ClockProfile_GetName(ClockProfile_Get()), SystemCoreClock,
+                            HAL_RCC_GetPCLK1Freq(), HAL_RCC_GetPCLK2Freq());
+        #endif
+    } else if (action == 'Q') {
+        #ifdef USE_PROFILER
+        if (args[0] == 'R') {
+            Profiler_Reset();
+            return;
+        }
+        #ifdef USE_UART_TELEMETRY
+        Profiler_Stats ps;
+        for (uint8_t i = 0; Profiler_GetStats((Profiler_Region)i, &ps); i++) {
+            uint32_t avg = ps.count ? (uint32_t)(ps.total / ps.count) : 0;
+            Telemetry_SendProfile(ps.name, ps.count, ps.min, avg, ps.max,
+                                  Profiler_CyclesPerUs());
+        }
+        #endif
+        #endif
+    } else if (action == 'H') {
+        #ifdef USE_ISR_STATS
+        if (args[0] == 'R') {
+            IsrStats_Reset();
+            return;
+        }
+        #ifdef USE_UART_TELEMETRY
+        static const char *const kinds[ISR_HIST_COUNT] = {"lat", "dur", "jit"};
+        Isr_Histogram hist;
+        for (uint8_t i = 0; i < ISR_COUNT; i++) {
+            for (uint8_t k = 0; k < ISR_HIST_COUNT; k++) {
+                if (IsrStats_Get((Isr_ID)i, (Isr_HistKind)k, &hist) && hist.count > 0) {
+                    Telemetry_SendHistogram(IsrStats_GetName((Isr_ID)i), kinds[k], hist.count,
+                                            hist.max, hist.bucket, ISR_STATS_BUCKETS);
+                }
+            }
+        }
+        #endif
+        #endif
+    } else if (action == 'U') {
+        #ifdef USE_UART_TELEMETRY
+        MemStats mem;
+        MemStats_Get(&mem);
+        Telemetry_SendMemory(mem.ram_total, mem.data, mem.bss, mem.heap_used, mem.heap_arena,
+                             mem.stack_used, mem.stack_free);
+        #endif
+    } else if (action == 'Y') {
+        #ifdef USE_TRACE
+        if (args[0] == 'C') {
+            Trace_Clear();
+            return;
+        }
+        #ifdef USE_UART_TELEMETRY
+        // Імена задач для аргументу TASK_BEGIN/END, далі записи - з задачі "trace"
+        Scheduler_TaskStats st;
+        for (uint8_t i = 0; Scheduler_GetStats(i, &st); i++) {
+            uint32_t avg = st.runs ? (uint32_t)(st.total_us / st.runs) : 0;
+            Telemetry_SendTask(i, st.name, st.runs, avg, st.max_us, st.overruns, st.missed);
+        }
+        uint32_t lost = 0;
+        uint32_t count = Trace_BeginDump(&lost);
+        Telemetry_SendTrace("begin", count, lost);
+        #endif
+        #endif
+    } else if (action == 'W') {
+        #if defined(USE_BENCH) && defined(USE_UART_TELEMETRY)
+        Bench_Result r;
+        for (uint8_t i = 0; Bench_Run(i, &r); i++) {
+            Telemetry_SendBenchmark(r.name, r.iterations, r.min, r.avg, r.max,
+                                    Profiler_CyclesPerUs());
+        }
+        #endif
+    } else if (action == 'G') {
+        #ifdef USE_RECORDER
+        if (args[0] == 'C') {
+            Recorder_Clear();
+            return;
+        }
+        #ifdef USE_UART_TELEMETRY
+        // Записи йдуть далі з задачі "recorder"
+        uint32_t lost = 0;
+        uint32_t bytes = Recorder_BeginDump(&lost);
+        Telemetry_SendRecorder("begin", bytes, lost);
+        #endif
+        #endif
+    }
+}
+
+void RemoteCommand_GetStats(RemoteCommand_Stats *stats)
+{
+    stats->lines = lines_received;
+    stats->dropped = lines_dropped;
+}
+
+/**
+ * @brief Send current odometry pose to ESP32
+ */
+void RemoteCommand_SendPose(void)
+{
+    #ifdef USE_UART_TELEMETRY
+    Odometry_Pose pose;
+    Odometry_GetPose(&pose);
+    Telemetry_SendPose(pose.x_mm, pose.y_mm, pose.heading_cdeg);
+    #endif
+}
+
+/**
+ * @brief Called by HAL after each received byte (interrupt-driven)
+ *        Re-arms itself to keep receiving.
+ */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance != USART1) return;
+
+    if (RemoteCommand_ReceiveByte((char)rx_byte))
+        Scheduler_Notify(notify_task);
+
+    // Re-arm for next byte
+    HAL_UART_Receive_IT(huart, &rx_byte, 1);
+}
@@ -0,0 +1,298 @@
+/**
+ * @file    scheduler.c
+ * @brief   Time-triggered cooperative task scheduler implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "scheduler.h"
+#include "trace.h"
+#include "timebase.h"
+
+/* Task control block */
+typedef struct {
+    Scheduler_TaskFn fn;
+    uint32_t phase_ms;
+    uint32_t next_release;      // Timebase time of the next release, us
+    Scheduler_TaskStats stats;
+} Scheduler_Task;
+
+static Scheduler_Task tasks[SCHEDULER_MAX_TASKS];
+static uint8_t task_count = 0;
+
+/* Notifications from ISRs (bit per task) and their timestamps, us */
+static volatile uint32_t notified = 0;
+static volatile uint32_t notify_time_us[SCHEDULER_MAX_TASKS];
+
+/* Idle and loop-time accounting over SCHEDULER_LOAD_WINDOW_MS */
+static uint32_t window_start_us = 0;
+static uint32_t window_idle_us = 0;
+static uint32_t window_sleeps = 0;
+static uint32_t window_loops = 0;
+static uint32_t window_loop_min_us = UINT32_MAX;
+static uint32_t window_loop_max_us = 0;
+static uint32_t window_longest_us = 0;
+static int8_t window_longest_id = -1;
+static uint32_t last_dispatch_us = 0;
+static Scheduler_IdleStats idle_stats;
+static Scheduler_LoadStats load_stats;
+
+/**
+ * @brief Initialize scheduler
+ */
+void Scheduler_Init(void)
+{
+    task_count = 0;
+    notified = 0;
+    window_start_us = Timebase_NowUs();
+    last_dispatch_us = window_start_us;
+    window_idle_us = 0;
+    window_sleeps = 0;
+    window_loops = 0;
+    window_loop_min_us = UINT32_MAX;
+    window_loop_max_us = 0;
+    window_longest_us = 0;
+    window_longest_id = -1;
+    idle_stats = (Scheduler_IdleStats){0};
+    load_stats = (Scheduler_LoadStats){0};
+    load_stats.longest_task = "none";
+}
+
+/**
+ * @brief Register a periodic task
+ */
+int8_t Scheduler_AddTask(const char *name, Scheduler_TaskFn fn,
+                         uint32_t period_ms, uint32_t phase_ms, uint32_t budget_us)
+{
+    if (task_count >= SCHEDULER_MAX_TASKS || fn == NULL || period_ms == 0) {
+        return -1;
+    }
+
+    /* A longer budget would break the wake-up latency bound */
+    if (budget_us == 0) budget_us = SCHEDULER_WAKE_LATENCY_US;
+    if (budget_us > SCHEDULER_WAKE_LATENCY_US) return -1;
+
+    Scheduler_Task *task = &tasks[task_count];
+    task->fn = fn;
+    task->phase_ms = phase_ms;
+    task->next_release = Timebase_NowUs() + phase_ms * 1000U;
+    task->stats = (Scheduler_TaskStats){0};
+    task->stats.name = name;
+    task->stats.period_ms = period_ms;
+    task->stats.budget_us = budget_us;
+
+    return (int8_t)task_count++;
+}
+
+/**
+ * @brief Align all releases to now
+ */
+void Scheduler_Start(void)
+{
+    uint32_t now = Timebase_NowUs();
+    for (uint8_t i = 0; i < task_count; i++) {
+        tasks[i].next_release = now + tasks[i].phase_ms * 1000U;
+    }
+}
+
+/**
+ * @brief Run a task and update its statistics
+ */
+static void Scheduler_Run(Scheduler_Task *task)
+{
+    TRACE(TASK_BEGIN, task - tasks, 0);
+    uint32_t start = Timebase_NowUs();
+    task->fn();
+    uint32_t elapsed_us = Timebase_ElapsedUs(start);
+    TRACE(TASK_END, task - tasks, elapsed_us);
+
+    Scheduler_TaskStats *s = &task->stats;
+    s->runs++;
+    s->last_us = elapsed_us;
+    s->total_us += elapsed_us;
+    if (elapsed_us > s->max_us) s->max_us = elapsed_us;
+    if (elapsed_us > s->budget_us) s->overruns++;
+
+    if (elapsed_us > window_longest_us) {
+        window_longest_us = elapsed_us;
+        window_longest_id = (int8_t)(task - tasks);
+    }
+}
+
+/**
+ * @brief Account one loop iteration, publish statistics at the window end
+ */
+static void Scheduler_Account(uint32_t now)
+{
+    uint32_t loop_us = now - last_dispatch_us;
+    last_dispatch_us = now;
+    window_loops++;
+    if (loop_us < window_loop_min_us) window_loop_min_us = loop_us;
+    if (loop_us > window_loop_max_us) window_loop_max_us = loop_us;
+
+    uint32_t window_us = now - window_start_us;
+    if (window_us < SCHEDULER_LOAD_WINDOW_MS * 1000U) return;
+
+    idle_stats.idle_percent = (uint8_t)(((uint64_t)window_idle_us * 100U) / window_us);
+    idle_stats.sleeps = window_sleeps;
+
+    load_stats.cpu_percent = (uint8_t)(100U - idle_stats.idle_percent);
+    load_stats.loops = window_loops;
+    load_stats.loop_min_us = window_loop_min_us;
+    load_stats.loop_avg_us = window_us / window_loops;
+    load_stats.loop_max_us = window_loop_max_us;
+    load_stats.longest_us = window_longest_us;
+    load_stats.longest_task = (window_longest_id >= 0) ?
+                              tasks[window_longest_id].stats.name : "none";
+
+    window_start_us = now;
+    window_idle_us = 0;
+    window_sleeps = 0;
+    window_loops = 0;
+    window_loop_min_us = UINT32_MAX;
+    window_loop_max_us = 0;
+    window_longest_us = 0;
+    window_longest_id = -1;
+}
+
+/**
+ * @brief Run notified tasks, in priority order
+ */
+static uint8_t Scheduler_RunNotified(void)
+{
+    uint8_t ran = 0;
+
+    while (notified != 0) {
+        uint8_t i = (uint8_t)__builtin_ctz(notified);
+
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        notified &= ~(1UL << i);
+        uint32_t latency = Timebase_ElapsedUs(notify_time_us[i]);
+        __set_PRIMASK(primask);
+
+        if (latency > idle_stats.wake_latency_max_us) idle_stats.wake_latency_max_us = latency;
+        if (latency > SCHEDULER_WAKE_LATENCY_US) idle_stats.latency_violations++;
+
+        Scheduler_Run(&tasks[i]);
+        ran++;
+    }
+
+    return ran;
+}
+
+/**
+ * @brief Run every due task once, in priority order
+ * Notifications raised meanwhile are served between periodic tasks.
+ */
+uint8_t Scheduler_Dispatch(void)
+{
+    Scheduler_Account(Timebase_NowUs());
+
+    uint8_t ran = Scheduler_RunNotified();
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        Scheduler_Task *task = &tasks[i];
+        uint32_t lateness = Timebase_ElapsedUs(task->next_release);
+
+        /* Not released yet (difference wraps to a large value) */
+        if ((int32_t)lateness < 0) continue;
+
+        Scheduler_Run(task);
+
+        Scheduler_TaskStats *s = &task->stats;
+        if (lateness > s->max_lateness_us) s->max_lateness_us = lateness;
+
+        /* Next release stays on the time grid; releases already past are dropped */
+        uint32_t period_us = s->period_ms * 1000U;
+        task->next_release += period_us;
+        if (lateness >= period_us) {
+            uint32_t skipped = lateness / period_us;
+            s->missed += skipped;
+            task->next_release += skipped * period_us;
+        }
+
+        ran++;
+        ran += Scheduler_RunNotified();
+    }
+
+    return ran;
+}
+
+/**
+ * @brief Make a task due now (ISR-safe)
+ */
+void Scheduler_Notify(int8_t id)
+{
+    if (id < 0 || id >= (int8_t)task_count) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    /* Keep the oldest timestamp if already pending */
+    if ((notified & (1UL << id)) == 0) {
+        notify_time_us[id] = Timebase_NowUs();
+        notified |= (1UL << id);
+        TRACE(NOTIFY, id, 0);
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Sleep until the next interrupt
+ * Interrupts are masked across the pending check so a notification that
+ * arrives just before WFI still wakes the core (WFI returns on a pending
+ * interrupt even with PRIMASK set; the handler runs after re-enabling).
+ * The idle interval ends at wake-up, before the waking handler runs, so
+ * its execution is counted as load, not idle.
+ */
+void Scheduler_Idle(void)
+{
+    __disable_irq();
+    uint32_t t0 = Timebase_NowUs();
+    if (notified == 0) {
+        __DSB();
+        __WFI();
+        window_sleeps++;
+    }
+    window_idle_us += Timebase_ElapsedUs(t0);
+    __enable_irq();
+}
+
+void Scheduler_GetIdleStats(Scheduler_IdleStats *stats)
+{
+    *stats = idle_stats;
+}
+
+void Scheduler_GetLoadStats(Scheduler_LoadStats *stats)
+{
+    *stats = load_stats;
+}
+
+uint8_t Scheduler_GetTaskCount(void)
+{
+    return task_count;
+}
+
+bool Scheduler_GetStats(uint8_t id, Scheduler_TaskStats *stats)
+{
+    if (id >= task_count) return false;
+    *stats = tasks[id].stats;
+    return true;
+}
+
+void Scheduler_ResetStats(void)
+{
+    for (uint8_t i = 0; i < task_count; i++) {
+        Scheduler_TaskStats *s = &tasks[i].stats;
+        s->runs = 0;
+        s->overruns = 0;
+        s->missed = 0;
+        s->last_us = 0;
+        s->max_us = 0;
+        s->total_us = 0;
+        s->max_lateness_us = 0;
+    }
+
+    idle_stats.wake_latency_max_us = 0;
+    idle_stats.latency_violations = 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file    speed_control.c
+ * @brief   Closed-loop per-motor PID speed controller implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Per tick and motor:
+ *   u = kff[dir] * |sp| + deadband[dir] + kp * e + I + kd * d(-rpm)/dt,  e = |sp| - rpm
+ *   (dir = setpoint sign: the calibration gives each direction its own line)
+ *   u is clamped to [0, 100] %; the integrator only accumulates while the
+ *   output is not saturated in the direction of the error (anti-windup).
+ */
+
+#include "speed_control.h"
+#include "drivers/sensors/encoder.h"
+#include "odometry.h"
+#include "autotune.h"
+#include "motor_characterize.h"
+#include "wheel_sync.h"
+#include "clock_profile.h"
+#include "profiler.h"
+#include "isr_stats.h"
+#include "trace.h"
+#include <math.h>
+
+/* Control period, s */
+#define SPEED_CONTROL_DT    (1.0f / SPEED_CONTROL_RATE_HZ)
+
+/* Control tick timer (TIM9, 1 MHz counter) */
+TIM_HandleTypeDef htim9;
+
+/* Controller state per motor */
+typedef struct {
+    SpeedControl_Gains gains;
+    float setpoint;         // RPM, signed (direction)
+    float integrator;       // %
+    float prev_rpm;         // RPM, for derivative on measurement
+    float output;           // %
+    bool enabled;
+} SpeedControl_State;
+
+static SpeedControl_State ctrl[MOTOR_COUNT];
+
+/**
+ * @brief One PID step for a motor
+ */
+static void Controller_Step(Motor_ID motor)
+{
+    SpeedControl_State *s = &ctrl[motor];
+    if (!s->enabled) return;
+
+    float target = fabsf(s->setpoint);
+    float rpm = Encoder_GetRPM((Encoder_ID)motor);
+
+    if (target == 0.0f) {
+        TB6612FNG_Stop(motor);
+        s->integrator = 0.0f;
+        s->output = 0.0f;
+        s->prev_rpm = rpm;
+        return;
+    }
+
+    float error = target - rpm;
+    float derivative = -(rpm - s->prev_rpm) / SPEED_CONTROL_DT;
+    s->prev_rpm = rpm;
+
+    uint8_t dir = (s->setpoint > 0.0f) ? SPEED_CONTROL_FWD : SPEED_CONTROL_REV;
+    float feed_forward = s->gains.kff[dir] * target + s->gains.deadband[dir];
+    float unclamped = feed_forward + s->gains.kp * error + s->integrator +
+                      s->gains.kd * derivative;
+
+    float output = unclamped;
+    if (output > SPEED_CONTROL_OUT_MAX) output = SPEED_CONTROL_OUT_MAX;
+    if (output < 0.0f) output = 0.0f;
+
+    /* Anti-windup: freeze integrator while saturated in the error direction */
+    bool saturated_high = (unclamped >= SPEED_CONTROL_OUT_MAX) && (error > 0.0f);
+    bool saturated_low  = (unclamped <= 0.0f) && (error < 0.0f);
+    if (!saturated_high && !saturated_low) {
+        s->integrator += s->gains.ki * error * SPEED_CONTROL_DT;
+        if (s->integrator > SPEED_CONTROL_OUT_MAX) s->integrator = SPEED_CONTROL_OUT_MAX;
+        if (s->integrator < -SPEED_CONTROL_OUT_MAX) s->integrator = -SPEED_CONTROL_OUT_MAX;
+    }
+
+    s->output = output;
+    TB6612FNG_Drive(motor, (s->setpoint > 0.0f) ? MOTOR_FORWARD : MOTOR_REVERSE,
+                    (uint8_t)(output + 0.5f));
+}
+
+/**
+ * @brief Initialize controllers and TIM9 control tick
+ */
+void SpeedControl_Init(void)
+{
+    for (uint8_t i = 0; i < MOTOR_COUNT; i++) {
+        ctrl[i].gains.kp = SPEED_CONTROL_KP_DEFAULT;
+        ctrl[i].gains.ki = SPEED_CONTROL_KI_DEFAULT;
+        ctrl[i].gains.kd = SPEED_CONTROL_KD_DEFAULT;
+        ctrl[i].gains.kff[SPEED_CONTROL_FWD] = SPEED_CONTROL_KFF_DEFAULT;
+        ctrl[i].gains.kff[SPEED_CONTROL_REV] = SPEED_CONTROL_KFF_DEFAULT;
+        ctrl[i].gains.deadband[SPEED_CONTROL_FWD] = 0.0f;
+        ctrl[i].gains.deadband[SPEED_CONTROL_REV] = 0.0f;
+        ctrl[i].setpoint = 0.0f;
+        ctrl[i].integrator = 0.0f;
+        ctrl[i].prev_rpm = 0.0f;
+        ctrl[i].output = 0.0f;
+        ctrl[i].enabled = false;
+    }
+
+    /* TIM9 on APB2, 1 MHz tick kept across clock profile switches */
+    __HAL_RCC_TIM9_CLK_ENABLE();
+
+    htim9.Instance = TIM9;
+    htim9.Init.Prescaler = ClockProfile_GetTimerPrescaler(TIM9);
+    htim9.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim9.Init.Period = 1000000 / SPEED_CONTROL_RATE_HZ - 1;
+    htim9.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim9.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&htim9) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    ClockProfile_AddTimer(&htim9);
+
+    HAL_NVIC_SetPriority(TIM1_BRK_TIM9_IRQn, SPEED_CONTROL_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM1_BRK_TIM9_IRQn);
+    HAL_TIM_Base_Start_IT(&htim9);
+}
+
+/**
+ * @brief Set setpoint and enable closed loop
+ */
+void SpeedControl_SetRPM(Motor_ID motor, float rpm)
+{
+    if (motor >= MOTOR_COUNT) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    SpeedControl_State *s = &ctrl[motor];
+    if (!s->enabled || (rpm > 0.0f) != (s->setpoint > 0.0f)) {
+        /* Fresh start or direction change: restart integrator */
+        s->integrator = 0.0f;
+        s->prev_rpm = Encoder_GetRPM((Encoder_ID)motor);
+    }
+    s->setpoint = rpm;
+    s->enabled = true;
+    __set_PRIMASK(primask);
+}
+
+float SpeedControl_GetSetpoint(Motor_ID motor)
+{
+    if (motor >= MOTOR_COUNT || !ctrl[motor].enabled) return 0.0f;
+    return ctrl[motor].setpoint;
+}
+
+float SpeedControl_GetOutput(Motor_ID motor)
+{
+    if (motor >= MOTOR_COUNT) return 0.0f;
+    return ctrl[motor].output;
+}
+
+void SpeedControl_Disable(Motor_ID motor)
+{
+    if (motor >= MOTOR_COUNT) return;
+    ctrl[motor].enabled = false;
+    ctrl[motor].setpoint = 0.0f;
+    ctrl[motor].output = 0.0f;
+}
+
+void SpeedControl_DisableAll(void)
+{
+    WheelSync_Disable();
+    Autotune_Abort();
+    MotorChar_Abort();
+    for (Motor_ID i = MOTOR_0; i < MOTOR_COUNT; i++) {
+        SpeedControl_Disable(i);
+    }
+}
+
+bool SpeedControl_IsEnabled(Motor_ID motor)
+{
+    if (motor >= MOTOR_COUNT) return false;
+    return ctrl[motor].enabled;
+}
+
+void SpeedControl_SetGains(Motor_ID motor, const SpeedControl_Gains *gains)
+{
+    if (motor >= MOTOR_COUNT) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    ctrl[motor].gains = *gains;
+    ctrl[motor].integrator = 0.0f;
+    __set_PRIMASK(primask);
+}
+
+void SpeedControl_GetGains(Motor_ID motor, SpeedControl_Gains *gains)
+{
+    if (motor >= MOTOR_COUNT) return;
+    *gains = ctrl[motor].gains;
+}
+
+/**
+ * @brief Control tick: measure, synchronize setpoints, control
+ *        (or auto-tune / characterize), integrate odometry
+ */
+void SpeedControl_Tick(void)
+{
+    PROFILE_BEGIN(CONTROL_TICK);
+    TRACE(CONTROL_BEGIN, 0, 0);
+
+    PROFILE_BEGIN(ENCODER_UPDATE);
+    Encoder_Update();
+    PROFILE_END(ENCODER_UPDATE);
+
+    WheelSync_Tick();
+
+    for (Motor_ID i = MOTOR_0; i < MOTOR_COUNT; i++) {
+        Controller_Step(i);
+    }
+    Autotune_Tick();
+    MotorChar_Tick();
+
+    Odometry_Update();
+
+    TRACE(CONTROL_END, 0, 0);
+    PROFILE_END(CONTROL_TICK);
+}
+
+/**
+ * @brief TIM9 update interrupt (shared vector with TIM1 break, unused)
+ */
+void TIM1_BRK_TIM9_IRQHandler(void)
+{
+    /* Counter restarts at the update event: CNT = ticks since the event */
+    ISR_STATS_ENTER_LATENCY(CONTROL, htim9.Instance->CNT * (htim9.Instance->PSC + 1));
+
+    if (__HAL_TIM_GET_FLAG(&htim9, TIM_FLAG_UPDATE)) {
+        __HAL_TIM_CLEAR_FLAG(&htim9, TIM_FLAG_UPDATE);
+        SpeedControl_Tick();
+    }
+
+    ISR_STATS_EXIT(CONTROL);
+}
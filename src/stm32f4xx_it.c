@@ -1,5 +1,6 @@
 #include "stm32f4xx_it.h"
 #include "uart_telemetry.h"  // for extern huart1
+#include "isr_stats.h"
 
 void NMI_Handler(void)
 {
@@ -47,10 +48,14 @@ void PendSV_Handler(void)
 
 void SysTick_Handler(void)
 {
+  ISR_STATS_ENTER_LATENCY(SYSTICK, SysTick->LOAD - SysTick->VAL);
   HAL_IncTick();
+  ISR_STATS_EXIT(SYSTICK);
 }
 
 void USART1_IRQHandler(void)
 {
+  ISR_STATS_ENTER(UART);
   HAL_UART_IRQHandler(&huart1);
+  ISR_STATS_EXIT(UART);
 }
@@ -0,0 +1,93 @@
+/**
+ * @file    timebase.c
+ * @brief   Free-running microsecond timebase implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "timebase.h"
+#include "clock_profile.h"
+
+/* TIM5 on APB1, 1 MHz counter, full 32-bit period */
+TIM_HandleTypeDef htim5;
+
+/* Upper 32 bits, incremented on counter overflow */
+static volatile uint32_t timebase_high = 0;
+
+void Timebase_Init(void)
+{
+    __HAL_RCC_TIM5_CLK_ENABLE();
+
+    htim5.Instance = TIMEBASE_TIM;
+    htim5.Init.Prescaler = ClockProfile_GetTimerPrescaler(TIMEBASE_TIM);
+    htim5.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim5.Init.Period = 0xFFFFFFFFUL;
+    htim5.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim5.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim5) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    /* Only a real overflow raises the update flag (not UG in Timebase_Retime) */
+    htim5.Instance->CR1 |= TIM_CR1_URS;
+    __HAL_TIM_CLEAR_FLAG(&htim5, TIM_FLAG_UPDATE);
+    timebase_high = 0;
+
+    HAL_NVIC_SetPriority(TIM5_IRQn, TIMEBASE_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM5_IRQn);
+    HAL_TIM_Base_Start_IT(&htim5);
+}
+
+void Timebase_Retime(void)
+{
+    if (htim5.Instance == NULL) return;     // Boot clock setup, not started yet
+
+    uint32_t psc = ClockProfile_GetTimerPrescaler(TIMEBASE_TIM);
+
+    /* PSC is only loaded on an update event: force one and restore the count */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t cnt = htim5.Instance->CNT;
+    htim5.Init.Prescaler = psc;
+    htim5.Instance->PSC = psc;
+    htim5.Instance->EGR = TIM_EGR_UG;
+    htim5.Instance->CNT = cnt;
+    /* Wrapped between the read and the write: the count is back before the
+     * wrap, which will flag again; counting it now would jump 2^32 ahead */
+    if ((htim5.Instance->SR & TIM_SR_UIF) && cnt >= 0x80000000UL) {
+        __HAL_TIM_CLEAR_FLAG(&htim5, TIM_FLAG_UPDATE);
+    }
+    __set_PRIMASK(primask);
+}
+
+uint64_t Timebase_NowUs64(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t high = timebase_high;
+    uint32_t low = htim5.Instance->CNT;
+    /* Overflowed, interrupt not served yet */
+    if ((htim5.Instance->SR & TIM_SR_UIF) && low < 0x80000000UL) high++;
+    __set_PRIMASK(primask);
+
+    return ((uint64_t)high << 32) | low;
+}
+
+void Timebase_DelayUs(uint32_t us)
+{
+    uint32_t start = Timebase_NowUs();
+    while (Timebase_ElapsedUs(start) < us) {
+    }
+}
+
+/**
+ * @brief TIM5 update interrupt: 32-bit counter overflow
+ */
+void TIM5_IRQHandler(void)
+{
+    if (__HAL_TIM_GET_FLAG(&htim5, TIM_FLAG_UPDATE)) {
+        __HAL_TIM_CLEAR_FLAG(&htim5, TIM_FLAG_UPDATE);
+        timebase_high++;
+    }
+}
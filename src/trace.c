@@ -0,0 +1,83 @@
+/**
+ * @file    trace.c
+ * @brief   Binary event trace ring buffer implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ */
+
+#include "trace.h"
+#include "timebase.h"
+
+#ifdef USE_TRACE
+
+static Trace_Entry trace_buffer[TRACE_BUFFER_SIZE];
+static volatile uint32_t trace_head = 0;       // Records written since clear
+static volatile bool trace_frozen = false;     // Dump in progress
+static uint32_t dump_next = 0;
+static uint32_t dump_end = 0;
+
+void Trace_Init(void)
+{
+    Trace_Clear();
+}
+
+void Trace_Record(Trace_Event event, uint16_t arg0, uint32_t arg1)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (trace_frozen) {
+        __set_PRIMASK(primask);
+        return;
+    }
+    Trace_Entry *e = &trace_buffer[trace_head++ & (TRACE_BUFFER_SIZE - 1)];
+    e->timestamp = Timebase_NowUs();
+    e->event = (uint16_t)event;
+    e->arg0 = arg0;
+    e->arg1 = arg1;
+    __set_PRIMASK(primask);
+}
+
+void Trace_Clear(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    trace_head = 0;
+    trace_frozen = false;
+    dump_next = 0;
+    dump_end = 0;
+    __set_PRIMASK(primask);
+}
+
+uint32_t Trace_BeginDump(uint32_t *lost)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    trace_frozen = true;
+    dump_end = trace_head;
+    __set_PRIMASK(primask);
+
+    uint32_t count = (dump_end > TRACE_BUFFER_SIZE) ? TRACE_BUFFER_SIZE : dump_end;
+    dump_next = dump_end - count;
+    if (lost != NULL) *lost = dump_next;
+    return count;
+}
+
+uint8_t Trace_ReadDump(Trace_Entry *out, uint8_t max)
+{
+    if (!trace_frozen) return 0;
+
+    uint8_t n = 0;
+    while (n < max && dump_next != dump_end) {
+        out[n++] = trace_buffer[dump_next++ & (TRACE_BUFFER_SIZE - 1)];
+    }
+
+    if (n == 0) Trace_Clear();
+    return n;
+}
+
+bool Trace_IsDumping(void)
+{
+    return trace_frozen;
+}
+
+#endif // USE_TRACE
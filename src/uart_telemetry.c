@@ -6,6 +6,9 @@
  */
 
 #include "uart_telemetry.h"
+#include "profiler.h"
+#include "dlog.h"
+#include "recorder.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -15,6 +18,19 @@ UART_HandleTypeDef huart1;
 /* Internal buffer for JSON formatting */
 static char telemetry_buffer[TELEMETRY_BUFFER_SIZE];
 
+/* Output switched off (formatting still runs) */
+static bool telemetry_muted;
+
+/**
+ * @brief Single output path of every message
+ */
+static void Telemetry_Transmit(const char* data, int len, uint32_t timeout)
+{
+    if (telemetry_muted) return;
+    RECORDER_OUTPUT(data, (uint16_t)len);
+    HAL_UART_Transmit(&huart1, (uint8_t*)data, (uint16_t)len, timeout);
+}
+
 /**
  * @brief Initialize UART1 for telemetry (PA9=TX, PA10=RX)
  */
@@ -34,11 +50,7 @@ void Telemetry_Init(void)
         Error_Handler();
     }
 
-    printf("\n=== UART Telemetry Initialized ===\n");
-    printf("UART: USART1\n");
-    printf("Baud: %d\n", TELEMETRY_BAUD_RATE);
-    printf("Pins: PA9 (TX), PA10 (RX)\n");
-    printf("Target: ESP32-WROOM-32D\n\n");
+    DLOG(TELEMETRY_INIT, TELEMETRY_BAUD_RATE);
 }
 
 /**
@@ -90,7 +102,7 @@ void Telemetry_SendButton(uint8_t button_id, uint8_t is_pressed)
                        is_pressed ? "pressed" : "released");
 
     if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
-        HAL_UART_Transmit(&huart1, (uint8_t*)telemetry_buffer, len, 10);
+        Telemetry_Transmit(telemetry_buffer, len, 10);
     }
 }
 
@@ -100,6 +112,7 @@ void Telemetry_SendButton(uint8_t button_id, uint8_t is_pressed)
  */
 void Telemetry_SendMotor(uint8_t motor_id, uint8_t direction, uint8_t speed)
 {
+    PROFILE_BEGIN(TELEMETRY_MOTOR);
     const char* dir_str;
     switch (direction) {
         case 1:  dir_str = "forward";  break;  /* MOTOR_FORWARD */
@@ -112,8 +125,9 @@ void Telemetry_SendMotor(uint8_t motor_id, uint8_t direction, uint8_t speed)
                        motor_id, dir_str, speed);
 
     if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
-        HAL_UART_Transmit(&huart1, (uint8_t*)telemetry_buffer, len, 10);
+        Telemetry_Transmit(telemetry_buffer, len, 10);
     }
+    PROFILE_END(TELEMETRY_MOTOR);
 }
 
 /**
@@ -130,7 +144,7 @@ void Telemetry_SendAllMotors(uint8_t* motor_states, uint8_t* motor_speeds)
                        motor_states[3] ? "running" : "stopped", motor_speeds[3]);
 
     if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
-        HAL_UART_Transmit(&huart1, (uint8_t*)telemetry_buffer, len, 10);
+        Telemetry_Transmit(telemetry_buffer, len, 10);
     }
 }
 
@@ -145,7 +159,323 @@ void Telemetry_SendRPM(uint8_t motor_id, float rpm)
                        motor_id, rpm);
 
     if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
-        HAL_UART_Transmit(&huart1, (uint8_t*)telemetry_buffer, len, 10);
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send encoder status as JSON
+ * Format: {"encoder":0,"rpm":325.5,"glitches":12}
+ */
+void Telemetry_SendEncoder(uint8_t encoder_id, float rpm, uint32_t glitches)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"encoder\":%d,\"rpm\":%.1f,\"glitches\":%lu}\n",
+                       encoder_id, rpm, (unsigned long)glitches);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send odometry pose as JSON
+ * Format: {"pose":{"x":1250,"y":-40,"heading":12.50}}
+ */
+void Telemetry_SendPose(int32_t x_mm, int32_t y_mm, int32_t heading_cdeg)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"pose\":{\"x\":%ld,\"y\":%ld,\"heading\":%.2f}}\n",
+                       (long)x_mm, (long)y_mm, heading_cdeg / 100.0f);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send closed-loop speed controller state as JSON
+ * Format: {"motor":0,"setpoint":120.0,"rpm":118.4,"duty":31.2}
+ */
+void Telemetry_SendSpeed(uint8_t motor_id, float setpoint, float rpm, float duty)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"motor\":%d,\"setpoint\":%.1f,\"rpm\":%.1f,\"duty\":%.1f}\n",
+                       motor_id, setpoint, rpm, duty);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send relay auto-tune result as JSON
+ * Format: {"autotune":0,"ok":1,"ku":0.412,"tu":0.184,"kp":0.185,"ki":1.209,"kd":0.000}
+ */
+void Telemetry_SendAutotune(uint8_t motor_id, uint8_t success, float ku, float tu_s,
+                            float kp, float ki, float kd)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"autotune\":%d,\"ok\":%d,\"ku\":%.3f,\"tu\":%.3f,"
+                       "\"kp\":%.3f,\"ki\":%.3f,\"kd\":%.3f}\n",
+                       motor_id, success, ku, tu_s, kp, ki, kd);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send motor calibration table as JSON
+ * Format: {"calib":0,"ok":1,"db":[11.2,12.0],"slope":[3.05,2.91],"tau":[84,90],"max":[270,258],"asym":4.7}
+ */
+void Telemetry_SendCalibration(uint8_t motor_id, uint8_t valid, const float* deadband,
+                               const float* slope, const uint16_t* tau_ms,
+                               const float* max_rpm, float asymmetry)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"calib\":%d,\"ok\":%d,\"db\":[%.1f,%.1f],\"slope\":[%.2f,%.2f],"
+                       "\"tau\":[%u,%u],\"max\":[%.0f,%.0f],\"asym\":%.1f}\n",
+                       motor_id, valid, deadband[0], deadband[1], slope[0], slope[1],
+                       tau_ms[0], tau_ms[1], max_rpm[0], max_rpm[1], asymmetry);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send scheduler task statistics as JSON
+ * Format: {"task":0,"name":"input","runs":1000,"avg_us":12,"max_us":40,"overruns":0,"missed":0}
+ */
+void Telemetry_SendTask(uint8_t task_id, const char* name, uint32_t runs, uint32_t avg_us,
+                        uint32_t max_us, uint32_t overruns, uint32_t missed)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"task\":%d,\"name\":\"%s\",\"runs\":%lu,\"avg_us\":%lu,"
+                       "\"max_us\":%lu,\"overruns\":%lu,\"missed\":%lu}\n",
+                       task_id, name, (unsigned long)runs, (unsigned long)avg_us,
+                       (unsigned long)max_us, (unsigned long)overruns, (unsigned long)missed);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send scheduler idle statistics as JSON
+ * Format: {"idle":85,"sleeps":1520,"wake_max_us":212,"late":0}
+ */
+void Telemetry_SendIdle(uint8_t idle_percent, uint32_t sleeps, uint32_t wake_max_us,
+                        uint32_t violations)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"idle\":%d,\"sleeps\":%lu,\"wake_max_us\":%lu,\"late\":%lu}\n",
+                       idle_percent, (unsigned long)sleeps, (unsigned long)wake_max_us,
+                       (unsigned long)violations);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send CPU load and main loop timing as JSON
+ * Format: {"cpu":12,"loops":1450,"loop_us":[8,689,1012],"block_us":4310,"block":"command"}
+ * loop_us = main loop period min, avg, max
+ */
+void Telemetry_SendLoad(uint8_t cpu_percent, uint32_t loops, uint32_t loop_min_us,
+                        uint32_t loop_avg_us, uint32_t loop_max_us, uint32_t block_us,
+                        const char* block_task)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"cpu\":%d,\"loops\":%lu,\"loop_us\":[%lu,%lu,%lu],"
+                       "\"block_us\":%lu,\"block\":\"%s\"}\n",
+                       cpu_percent, (unsigned long)loops, (unsigned long)loop_min_us,
+                       (unsigned long)loop_avg_us, (unsigned long)loop_max_us,
+                       (unsigned long)block_us, block_task);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send RAM usage as JSON (bytes)
+ * Format: {"ram":131072,"data":120,"bss":4816,"heap":[1428,2048],"stack":[1864,121512]}
+ * heap = used, claimed from sbrk; stack = high-water mark, never touched gap
+ */
+void Telemetry_SendMemory(uint32_t ram_total, uint32_t data, uint32_t bss, uint32_t heap_used,
+                          uint32_t heap_arena, uint32_t stack_used, uint32_t stack_free)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"ram\":%lu,\"data\":%lu,\"bss\":%lu,\"heap\":[%lu,%lu],"
+                       "\"stack\":[%lu,%lu]}\n",
+                       (unsigned long)ram_total, (unsigned long)data, (unsigned long)bss,
+                       (unsigned long)heap_used, (unsigned long)heap_arena,
+                       (unsigned long)stack_used, (unsigned long)stack_free);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send trace dump framing as JSON
+ * Format: {"trace":"begin","n":256,"lost":1840}
+ */
+void Telemetry_SendTrace(const char* state, uint32_t count, uint32_t lost)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"trace\":\"%s\",\"n\":%lu,\"lost\":%lu}\n",
+                       state, (unsigned long)count, (unsigned long)lost);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send binary data as {"key":"hex"}
+ */
+static void Telemetry_SendHex(const char* key, const uint8_t* data, uint16_t size)
+{
+    static const char hex[] = "0123456789abcdef";
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE, "{\"%s\":\"", key);
+
+    for (uint16_t i = 0; i < size && len + 2 < TELEMETRY_BUFFER_SIZE; i++) {
+        telemetry_buffer[len++] = hex[data[i] >> 4];
+        telemetry_buffer[len++] = hex[data[i] & 0x0F];
+    }
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        len += snprintf(telemetry_buffer + len, TELEMETRY_BUFFER_SIZE - len, "\"}\n");
+    }
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send raw trace records as hex
+ * Format: {"tr":"<hex>"} (bytes in memory order, little-endian records)
+ */
+void Telemetry_SendTraceData(const uint8_t* data, uint16_t size)
+{
+    Telemetry_SendHex("tr", data, size);
+}
+
+/**
+ * @brief Send deferred log records as a hex string
+ * Format: {"log":"0400010012340000..."}
+ */
+void Telemetry_SendLog(const uint32_t* words, uint8_t count)
+{
+    Telemetry_SendHex("log", (const uint8_t*)words, (uint16_t)(count * sizeof(uint32_t)));
+}
+
+/**
+ * @brief Send session recorder dump framing as JSON
+ * Format: {"rec":"begin","n":3912,"lost":17}
+ */
+void Telemetry_SendRecorder(const char* state, uint32_t bytes, uint32_t lost)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"rec\":\"%s\",\"n\":%lu,\"lost\":%lu}\n",
+                       state, (unsigned long)bytes, (unsigned long)lost);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send raw session records as hex
+ * Format: {"rd":"<hex>"} (byte stream, records may continue on the next line)
+ */
+void Telemetry_SendRecorderData(const uint8_t* data, uint16_t size)
+{
+    Telemetry_SendHex("rd", data, size);
+}
+
+/**
+ * @brief Send clock profile as JSON
+ * Format: {"clock":"balanced","sysclk":96000000,"pclk1":48000000,"pclk2":96000000}
+ */
+void Telemetry_SendClock(const char* profile, uint32_t sysclk, uint32_t pclk1, uint32_t pclk2)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"clock\":\"%s\",\"sysclk\":%lu,\"pclk1\":%lu,\"pclk2\":%lu}\n",
+                       profile, (unsigned long)sysclk, (unsigned long)pclk1,
+                       (unsigned long)pclk2);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send profiler region statistics as JSON
+ * Format: {"prof":"encoder_update","n":5000,"min":410,"avg":455,"max":1210,"cyc_us":96}
+ */
+void Telemetry_SendProfile(const char* name, uint32_t count, uint32_t min_cycles,
+                           uint32_t avg_cycles, uint32_t max_cycles, uint32_t cycles_per_us)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"prof\":\"%s\",\"n\":%lu,\"min\":%lu,\"avg\":%lu,"
+                       "\"max\":%lu,\"cyc_us\":%lu}\n",
+                       name, (unsigned long)count, (unsigned long)min_cycles,
+                       (unsigned long)avg_cycles, (unsigned long)max_cycles,
+                       (unsigned long)cycles_per_us);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
+    }
+}
+
+/**
+ * @brief Send log2 histogram as JSON (bucket 0 = 0, bucket k = [2^(k-1), 2^k) cycles, jitter in us)
+ * Format: {"isr":"control","kind":"lat","n":5000,"max":288,"hist":[0,0,0,0,0,0,0,4990,10]}
+ * Trailing empty buckets are omitted to keep the line short.
+ */
+void Telemetry_SendHistogram(const char* name, const char* kind, uint32_t count,
+                             uint32_t max, const uint32_t* buckets, uint8_t bucket_count)
+{
+    while (bucket_count > 1 && buckets[bucket_count - 1] == 0) bucket_count--;
+
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"isr\":\"%s\",\"kind\":\"%s\",\"n\":%lu,\"max\":%lu,\"hist\":[",
+                       name, kind, (unsigned long)count, (unsigned long)max);
+
+    for (uint8_t i = 0; i < bucket_count && len > 0 && len < TELEMETRY_BUFFER_SIZE; i++) {
+        len += snprintf(telemetry_buffer + len, TELEMETRY_BUFFER_SIZE - len, "%s%lu",
+                        (i > 0) ? "," : "", (unsigned long)buckets[i]);
+    }
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        len += snprintf(telemetry_buffer + len, TELEMETRY_BUFFER_SIZE - len, "]}\n");
+    }
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 20);
+    }
+}
+
+/**
+ * @brief Send benchmark result as JSON
+ * Format: {"bench":"telemetry_motor","n":1024,"min":2210,"avg":2290,"max":4120,"cyc_us":100}
+ */
+void Telemetry_SendBenchmark(const char* name, uint32_t iterations, uint32_t min_cycles,
+                             uint32_t avg_cycles, uint32_t max_cycles, uint32_t cycles_per_us)
+{
+    int len = snprintf(telemetry_buffer, TELEMETRY_BUFFER_SIZE,
+                       "{\"bench\":\"%s\",\"n\":%lu,\"min\":%lu,\"avg\":%lu,"
+                       "\"max\":%lu,\"cyc_us\":%lu}\n",
+                       name, (unsigned long)iterations, (unsigned long)min_cycles,
+                       (unsigned long)avg_cycles, (unsigned long)max_cycles,
+                       (unsigned long)cycles_per_us);
+
+    if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
+        Telemetry_Transmit(telemetry_buffer, len, 10);
     }
 }
 
@@ -156,10 +486,10 @@ void Telemetry_SendJSON(const char* json_string)
 {
     int len = strlen(json_string);
     if (len > 0 && len < TELEMETRY_BUFFER_SIZE) {
-        HAL_UART_Transmit(&huart1, (uint8_t*)json_string, len, HAL_MAX_DELAY);
+        Telemetry_Transmit(json_string, len, HAL_MAX_DELAY);
         // Add newline if not present
         if (json_string[len - 1] != '\n') {
-            HAL_UART_Transmit(&huart1, (uint8_t*)"\n", 1, 10);
+            Telemetry_Transmit("\n", 1, 10);
         }
     }
 }
@@ -171,6 +501,14 @@ void Telemetry_SendString(const char* message)
 {
     int len = strlen(message);
     if (len > 0) {
-        HAL_UART_Transmit(&huart1, (uint8_t*)message, len, 10);
+        Telemetry_Transmit(message, len, 10);
     }
 }
+
+/**
+ * @brief Switch UART output off/on (messages are still formatted)
+ */
+void Telemetry_SetMuted(bool muted)
+{
+    telemetry_muted = muted;
+}
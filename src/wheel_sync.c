@@ -0,0 +1,126 @@
+/**
+ * @file    wheel_sync.c
+ * @brief   Cross-coupled wheel synchronization implementation
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Works on travel magnitudes (single-channel encoders): the commanded sign
+ * of each side only selects the direction of the corrected setpoint.
+ */
+
+#include "wheel_sync.h"
+#include "speed_control.h"
+#include "drivers/sensors/encoder.h"
+#include <math.h>
+
+/* Synchronization state (shared between main loop and control tick) */
+static struct {
+    volatile bool active;
+    float left_rpm;                 // Nominal setpoints
+    float right_rpm;
+    uint32_t start[MOTOR_COUNT];    // Encoder counts at WheelSync_Drive
+    volatile int32_t side_error;
+} ws;
+
+/**
+ * @brief Clamp correction so it never exceeds the limit or flips direction
+ */
+static float WheelSync_Clamp(float correction, float nominal)
+{
+    float limit = 0.5f * nominal;
+    if (limit > WHEEL_SYNC_MAX_CORR_RPM) limit = WHEEL_SYNC_MAX_CORR_RPM;
+    if (correction > limit) return limit;
+    if (correction < -limit) return -limit;
+    return correction;
+}
+
+/**
+ * @brief A wheel with no pulses follows its axle partner (no encoder fitted)
+ */
+static void WheelSync_FillAbsent(uint32_t *a, uint32_t *b)
+{
+    if (*a == 0 && *b > WHEEL_SYNC_ABSENT_COUNTS) *a = *b;
+    if (*b == 0 && *a > WHEEL_SYNC_ABSENT_COUNTS) *b = *a;
+}
+
+void WheelSync_Drive(float left_rpm, float right_rpm)
+{
+    if (left_rpm == 0.0f && right_rpm == 0.0f) {
+        WheelSync_Disable();
+        for (Motor_ID i = MOTOR_0; i < MOTOR_COUNT; i++) {
+            SpeedControl_SetRPM(i, 0.0f);
+        }
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8_t i = 0; i < MOTOR_COUNT; i++) {
+        ws.start[i] = Encoder_GetCount((Encoder_ID)i);
+    }
+    ws.left_rpm = left_rpm;
+    ws.right_rpm = right_rpm;
+    ws.side_error = 0;
+    SpeedControl_SetRPM(MOTOR_0, left_rpm);
+    SpeedControl_SetRPM(MOTOR_1, left_rpm);
+    SpeedControl_SetRPM(MOTOR_2, right_rpm);
+    SpeedControl_SetRPM(MOTOR_3, right_rpm);
+    ws.active = true;
+    __set_PRIMASK(primask);
+}
+
+void WheelSync_Disable(void)
+{
+    ws.active = false;
+}
+
+bool WheelSync_IsActive(void)
+{
+    return ws.active;
+}
+
+int32_t WheelSync_GetSideError(void)
+{
+    return ws.side_error;
+}
+
+/**
+ * @brief Adjust setpoints from the travel errors
+ */
+void WheelSync_Tick(void)
+{
+    if (!ws.active) return;
+
+    uint32_t travel[MOTOR_COUNT];
+    for (uint8_t i = 0; i < MOTOR_COUNT; i++) {
+        travel[i] = Encoder_GetCount((Encoder_ID)i) - ws.start[i];
+    }
+    WheelSync_FillAbsent(&travel[0], &travel[1]);
+    WheelSync_FillAbsent(&travel[2], &travel[3]);
+
+    float left = fabsf(ws.left_rpm);
+    float right = fabsf(ws.right_rpm);
+    float left_travel = 0.5f * (float)(travel[0] + travel[1]);
+    float right_travel = 0.5f * (float)(travel[2] + travel[3]);
+
+    /* Side error in counts, scaled so equal progress at the commanded ratio is 0 */
+    float side_error = (left_travel * right - right_travel * left) / (0.5f * (left + right));
+    float left_axle_error = (float)travel[0] - (float)travel[1];
+    float right_axle_error = (float)travel[2] - (float)travel[3];
+    ws.side_error = (int32_t)side_error;
+
+    float side = WHEEL_SYNC_K_SIDE * side_error;
+    float correction[MOTOR_COUNT] = {
+        WheelSync_Clamp(-side - WHEEL_SYNC_K_AXLE * left_axle_error, left),
+        WheelSync_Clamp(-side + WHEEL_SYNC_K_AXLE * left_axle_error, left),
+        WheelSync_Clamp( side - WHEEL_SYNC_K_AXLE * right_axle_error, right),
+        WheelSync_Clamp( side + WHEEL_SYNC_K_AXLE * right_axle_error, right)
+    };
+
+    float left_sign = (ws.left_rpm < 0.0f) ? -1.0f : 1.0f;
+    float right_sign = (ws.right_rpm < 0.0f) ? -1.0f : 1.0f;
+    SpeedControl_SetRPM(MOTOR_0, left_sign * (left + correction[0]));
+    SpeedControl_SetRPM(MOTOR_1, left_sign * (left + correction[1]));
+    SpeedControl_SetRPM(MOTOR_2, right_sign * (right + correction[2]));
+    SpeedControl_SetRPM(MOTOR_3, right_sign * (right + correction[3]));
+}
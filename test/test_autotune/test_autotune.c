@@ -0,0 +1,119 @@
+/**
+ * @file    test_autotune.c
+ * @brief   Relay auto-tune ("C:T") on the simulated motor plant
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Runs on the HAL mock with motor_sim.c default parameters, without a
+ * prior characterization (feed-forward at its defaults), i.e. the case
+ * AUTOTUNE_RELAY_DEFAULT is chosen for.
+ *   pio test -e native_test -f test_autotune
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "main.h"
+#include "hal_mock.h"
+#include "motor_sim.h"
+#include "app_tasks.h"
+#include "clock_profile.h"
+#include "timebase.h"
+#include "remote_command.h"
+#include "speed_control.h"
+#include "autotune.h"
+#include "wheel_sync.h"
+#include "drivers/sensors/encoder.h"
+
+#define POLL_MS         100
+#define SETTLE_MS       3000    // Closed loop with the tuned gains
+
+static void DiscardTx(const USART_TypeDef *usart, const uint8_t *data, uint16_t size)
+{
+    (void)usart; (void)data; (void)size;
+}
+
+static void RunMs(uint32_t ms)
+{
+    HalMock_AdvanceUs((uint64_t)ms * 1000U);
+}
+
+/**
+ * @brief Run until the experiment publishes its result
+ */
+static bool WaitResult(Autotune_Result *result)
+{
+    for (uint32_t t = 0; t <= AUTOTUNE_TIMEOUT_MS + 1000; t += POLL_MS) {
+        if (Autotune_PollResult(result)) return true;
+        RunMs(POLL_MS);
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    HalMock_Reset();
+    HalMock_SetTxHook(DiscardTx);
+
+    HAL_Init();
+    ClockProfile_Init(CLOCK_PROFILE_DEFAULT);
+    Timebase_Init();
+    App_Init();
+    MotorSim_Init();
+}
+
+void tearDown(void) {}
+
+static void test_default_relay_finds_limit_cycle(void)
+{
+    static const int setpoints[] = { 40, 80, 120, 160 };
+    char cmd[24];
+
+    for (uint8_t i = 0; i < sizeof(setpoints) / sizeof(setpoints[0]); i++) {
+        Autotune_Result r;
+        snprintf(cmd, sizeof(cmd), "C:T:0:%d", setpoints[i]);
+        RemoteCommand_Execute(cmd);
+        TEST_ASSERT_TRUE(Autotune_IsRunning());
+
+        TEST_ASSERT_TRUE(WaitResult(&r));
+        TEST_ASSERT_EQUAL_INT(AUTOTUNE_DONE, r.state);
+        TEST_ASSERT_TRUE(isfinite(r.ku) && r.ku > 0.0f);
+        TEST_ASSERT_TRUE(isfinite(r.tu_s) && r.tu_s > 0.0f);
+        TEST_ASSERT_GREATER_THAN_FLOAT(AUTOTUNE_HYSTERESIS_RPM, r.amplitude_rpm);
+    }
+}
+
+static void test_tuned_gains_hold_speed(void)
+{
+    Autotune_Result r;
+    RemoteCommand_Execute("C:T:0:120");
+    TEST_ASSERT_TRUE(WaitResult(&r));
+    TEST_ASSERT_EQUAL_INT(AUTOTUNE_DONE, r.state);
+
+    RemoteCommand_Execute("C:V:0:120");
+    RunMs(SETTLE_MS);
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, 120.0f, Encoder_GetRPM(ENCODER_0));
+}
+
+static void test_tune_stops_wheel_sync(void)
+{
+    RemoteCommand_Execute("C:D:100:100");
+    RunMs(500);
+    TEST_ASSERT_TRUE(WheelSync_IsActive());
+
+    /* Synchronization would re-arm the loop under the relay every tick */
+    RemoteCommand_Execute("C:T:0:120");
+    TEST_ASSERT_FALSE(WheelSync_IsActive());
+    RunMs(500);
+    TEST_ASSERT_TRUE(Autotune_IsTesting(MOTOR_0));
+    TEST_ASSERT_FALSE(SpeedControl_IsEnabled(MOTOR_0));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_default_relay_finds_limit_cycle);
+    RUN_TEST(test_tuned_gains_hold_speed);
+    RUN_TEST(test_tune_stops_wheel_sync);
+    return UNITY_END();
+}
@@ -0,0 +1,97 @@
+/**
+ * @file    test_commands.c
+ * @brief   Remote commands against running experiments on the simulated motors
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Commands go straight to RemoteCommand_Execute; the control tick (speed
+ * loop, auto-tune, characterization) runs in TIM9 on the HAL mock with
+ * motor_sim.c as the plant.
+ *   pio test -e native_test -f test_commands
+ */
+
+#include <unity.h>
+#include "main.h"
+#include "hal_mock.h"
+#include "motor_sim.h"
+#include "app_tasks.h"
+#include "clock_profile.h"
+#include "timebase.h"
+#include "remote_command.h"
+#include "speed_control.h"
+#include "motor_characterize.h"
+#include "drivers/sensors/encoder.h"
+
+#define SWEEP_MS        3000    // Into the duty sweep of motor 0
+#define SETTLE_MS       4000    // Closed loop settling after C:V (slow at 47 RPM)
+
+static void DiscardTx(const USART_TypeDef *usart, const uint8_t *data, uint16_t size)
+{
+    (void)usart; (void)data; (void)size;
+}
+
+static void RunMs(uint32_t ms)
+{
+    HalMock_AdvanceUs((uint64_t)ms * 1000U);
+}
+
+void setUp(void)
+{
+    HalMock_Reset();
+    HalMock_SetTxHook(DiscardTx);
+
+    HAL_Init();
+    ClockProfile_Init(CLOCK_PROFILE_DEFAULT);
+    Timebase_Init();
+    App_Init();
+    MotorSim_Init();
+}
+
+void tearDown(void) {}
+
+static void test_closed_loop_stops_characterization(void)
+{
+    RemoteCommand_Execute("C:X:0");
+    RunMs(SWEEP_MS);
+    TEST_ASSERT_TRUE(MotorChar_IsTesting(MOTOR_0));
+
+    RemoteCommand_Execute("C:V:0:47");
+    TEST_ASSERT_FALSE(MotorChar_IsRunning());
+
+    /* The loop owns the motor: it settles instead of winding up */
+    RunMs(SETTLE_MS);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 47.0f, Encoder_GetRPM(ENCODER_0));
+    TEST_ASSERT_LESS_THAN_FLOAT(100.0f, SpeedControl_GetOutput(MOTOR_0));
+}
+
+static void test_abort_stops_sweep_and_motor(void)
+{
+    RemoteCommand_Execute("C:X:0");
+    RunMs(SWEEP_MS);
+
+    RemoteCommand_Execute("C:X:S");
+    TEST_ASSERT_FALSE(MotorChar_IsRunning());
+
+    RunMs(SETTLE_MS);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, Encoder_GetRPM(ENCODER_0));
+}
+
+static void test_abort_keeps_closed_loop(void)
+{
+    RemoteCommand_Execute("C:V:1:80");
+    RunMs(100);
+
+    /* Only the sweep is aborted, not every loop */
+    RemoteCommand_Execute("C:X:S");
+    TEST_ASSERT_TRUE(SpeedControl_IsEnabled(MOTOR_1));
+    TEST_ASSERT_EQUAL_FLOAT(80.0f, SpeedControl_GetSetpoint(MOTOR_1));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_closed_loop_stops_characterization);
+    RUN_TEST(test_abort_stops_sweep_and_motor);
+    RUN_TEST(test_abort_keeps_closed_loop);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+/**
+ * @file    test_timebase.c
+ * @brief   Microsecond timebase across clock profile switches
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * The HAL mock runs the PLL lock (HALMOCK_PLL_LOCK_US) in virtual time
+ * with SYSCLK on HSE, so a timer left on the old prescaler counts at the
+ * wrong rate for that long. A step hook reads Timebase_NowUs64 every
+ * simulated microsecond, like an interrupt would during the switch.
+ *   pio test -e native_test -f test_timebase
+ */
+
+#include <unity.h>
+#include "main.h"
+#include "hal_mock.h"
+#include "clock_profile.h"
+#include "timebase.h"
+
+#define SWITCH_SKEW_US      2       // Allowed loss per profile switch
+
+static uint64_t last_read;
+static uint32_t backwards;
+static uint32_t reads;
+
+/**
+ * @brief Reader running every microsecond, also inside the switch
+ */
+static void ReadHook(uint64_t now_us)
+{
+    (void)now_us;
+    uint64_t t = Timebase_NowUs64();
+    if (t < last_read) backwards++;
+    last_read = t;
+    reads++;
+}
+
+void setUp(void)
+{
+    HalMock_Reset();
+    HAL_Init();
+    ClockProfile_Init(CLOCK_PROFILE_DEFAULT);
+    Timebase_Init();
+
+    last_read = 0;
+    backwards = 0;
+    reads = 0;
+}
+
+void tearDown(void) {}
+
+static void test_switch_keeps_time(void)
+{
+    static const Clock_Profile sequence[] = {
+        CLOCK_PROFILE_ECONOMY, CLOCK_PROFILE_PERFORMANCE,
+        CLOCK_PROFILE_BALANCED, CLOCK_PROFILE_ECONOMY, CLOCK_PROFILE_BALANCED
+    };
+    HalMock_AdvanceUs(1000);
+
+    for (uint8_t i = 0; i < sizeof(sequence) / sizeof(sequence[0]); i++) {
+        uint64_t mock0 = HalMock_NowUs();
+        uint64_t tb0 = Timebase_NowUs64();
+
+        TEST_ASSERT_TRUE(ClockProfile_Set(sequence[i]));
+        HalMock_AdvanceUs(500);
+
+        int64_t skew = (int64_t)(HalMock_NowUs() - mock0) - (int64_t)(Timebase_NowUs64() - tb0);
+        TEST_ASSERT_INT_WITHIN(SWITCH_SKEW_US, 0, skew);
+    }
+}
+
+static void test_time_never_goes_backwards(void)
+{
+    HalMock_AddStepHook(ReadHook);
+    HalMock_AdvanceUs(100);
+
+    for (uint8_t i = 0; i < 20; i++) {
+        TEST_ASSERT_TRUE(ClockProfile_Set((Clock_Profile)(i % CLOCK_PROFILE_COUNT)));
+        HalMock_AdvanceUs(37);
+    }
+
+    TEST_ASSERT_GREATER_THAN(20 * HALMOCK_PLL_LOCK_US, reads);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+}
+
+static void test_counter_rate_after_switch(void)
+{
+    TEST_ASSERT_TRUE(ClockProfile_Set(CLOCK_PROFILE_ECONOMY));
+
+    uint32_t t0 = Timebase_NowUs();
+    HalMock_AdvanceUs(10000);
+    TEST_ASSERT_EQUAL_UINT32(10000, Timebase_ElapsedUs(t0));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_switch_keeps_time);
+    RUN_TEST(test_time_never_goes_backwards);
+    RUN_TEST(test_counter_rate_after_switch);
+    return UNITY_END();
+}
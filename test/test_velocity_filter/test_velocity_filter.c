@@ -0,0 +1,165 @@
+/**
+ * @file    test_velocity_filter.c
+ * @brief   Step and ramp response of the encoder velocity filters
+ * @author  STM32 Black Pill Project
+ * @date    2026-10-18
+ *
+ * Samples at the 500 Hz control rate (2 ms); a step from rest to
+ * 1000 RPM, settling = last sample outside +/-2 % of the final value.
+ *   pio test -e native_test -f test_velocity_filter
+ */
+
+#include <unity.h>
+#include "drivers/sensors/velocity_filter.h"
+
+#define SAMPLE_US       2000
+#define STEP_RPM        1000
+#define STEP_SAMPLES    200
+#define SETTLE_BAND     0.02f
+
+static VFilter filter;
+static float response[STEP_SAMPLES];
+
+typedef struct {
+    int settle;             // Samples until the output stays in the band
+    float overshoot;        // Peak above the step, % of the step
+    bool monotonic;         // Never decreased
+} StepResult;
+
+static float Feed(float rpm)
+{
+    return Q16_TO_FLOAT(VFilter_Update(&filter, Q16_FROM_FLOAT(rpm), SAMPLE_US));
+}
+
+/**
+ * @brief Prime at rest, then step to STEP_RPM
+ */
+static StepResult Step(VFilter_Type type)
+{
+    StepResult r = {0, 0.0f, true};
+    float peak = 0.0f;
+
+    VFilter_Init(&filter, type);
+    for (int i = 0; i < 10; i++) Feed(0.0f);
+
+    for (int i = 0; i < STEP_SAMPLES; i++) {
+        response[i] = Feed(STEP_RPM);
+        if (response[i] > peak) peak = response[i];
+        if (i > 0 && response[i] < response[i - 1]) r.monotonic = false;
+        if (response[i] < STEP_RPM * (1.0f - SETTLE_BAND) ||
+            response[i] > STEP_RPM * (1.0f + SETTLE_BAND)) {
+            r.settle = i + 1;
+        }
+    }
+    r.overshoot = (peak - STEP_RPM) * 100.0f / STEP_RPM;
+    return r;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_first_sample_primes_output(void)
+{
+    VFilter_Init(&filter, VFILTER_IIR);
+    TEST_ASSERT_EQUAL_FLOAT(250.0f, Feed(250.0f));
+}
+
+static void test_iir_step(void)
+{
+    StepResult r = Step(VFILTER_IIR);
+
+    /* alpha = 0.25: error shrinks 0.75x per sample, 0.75^14 < 2 % */
+    TEST_ASSERT_TRUE(r.monotonic);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, r.overshoot);
+    TEST_ASSERT_LESS_OR_EQUAL(14, r.settle);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, STEP_RPM * 0.25f, response[0]);
+}
+
+static void test_iir_smaller_alpha_is_slower(void)
+{
+    StepResult fast = Step(VFILTER_IIR);
+
+    VFilter_Init(&filter, VFILTER_IIR);
+    VFilter_SetIIR(&filter, Q16_FROM_FLOAT(0.1f));
+    for (int i = 0; i < 10; i++) Feed(0.0f);
+    int settle = 0;
+    for (int i = 0; i < STEP_SAMPLES; i++) {
+        if (Feed(STEP_RPM) < STEP_RPM * (1.0f - SETTLE_BAND)) settle = i + 1;
+    }
+    TEST_ASSERT_GREATER_THAN(fast.settle, settle);
+}
+
+static void test_median_step(void)
+{
+    StepResult r = Step(VFILTER_MEDIAN);
+
+    /* 5-sample window: the step passes unchanged once it is the majority */
+    TEST_ASSERT_TRUE(r.monotonic);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, r.overshoot);
+    TEST_ASSERT_EQUAL_INT(VFILTER_MEDIAN_WINDOW / 2, r.settle);
+    TEST_ASSERT_EQUAL_FLOAT(STEP_RPM, response[VFILTER_MEDIAN_WINDOW / 2]);
+}
+
+static void test_median_rejects_single_spike(void)
+{
+    VFilter_Init(&filter, VFILTER_MEDIAN);
+    for (int i = 0; i < 10; i++) Feed(500.0f);
+
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, Feed(5000.0f));
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, Feed(500.0f));
+}
+
+static void test_alpha_beta_step(void)
+{
+    StepResult r = Step(VFILTER_ALPHA_BETA);
+
+    /* Velocity state overshoots a step; bounded and settled within 40 ms */
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.0f, r.overshoot);
+    TEST_ASSERT_LESS_THAN_FLOAT(10.0f, r.overshoot);
+    TEST_ASSERT_LESS_OR_EQUAL(20, r.settle);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, STEP_RPM, response[STEP_SAMPLES - 1]);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, Q16_TO_FLOAT(filter.accel));
+}
+
+static void test_alpha_beta_tracks_ramp(void)
+{
+    /* 1000 RPM/s = 2 RPM per sample */
+    const float slope = 1000.0f;
+    const float per_sample = slope * SAMPLE_US / 1000000.0f;
+    float input = 100.0f, output = 0.0f;
+
+    VFilter_Init(&filter, VFILTER_ALPHA_BETA);
+    for (int i = 0; i < 10; i++) Feed(input);
+
+    for (int i = 0; i < 100; i++) {
+        input += per_sample;
+        output = Feed(input);
+    }
+
+    /* Constant acceleration is tracked without lag */
+    TEST_ASSERT_FLOAT_WITHIN(slope * 0.01f, slope, Q16_TO_FLOAT(filter.accel));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, input, output);
+}
+
+static void test_alpha_beta_deceleration_sign(void)
+{
+    VFilter_Init(&filter, VFILTER_ALPHA_BETA);
+    for (int i = 0; i < 10; i++) Feed(800.0f);
+    for (int i = 0; i < 50; i++) Feed(800.0f - 4.0f * (i + 1));
+
+    TEST_ASSERT_LESS_THAN_FLOAT(0.0f, Q16_TO_FLOAT(filter.accel));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_sample_primes_output);
+    RUN_TEST(test_iir_step);
+    RUN_TEST(test_iir_smaller_alpha_is_slower);
+    RUN_TEST(test_median_step);
+    RUN_TEST(test_median_rejects_single_spike);
+    RUN_TEST(test_alpha_beta_step);
+    RUN_TEST(test_alpha_beta_tracks_ramp);
+    RUN_TEST(test_alpha_beta_deceleration_sign);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""
+Benchmark results: collect, convert to ns and compare against a baseline.
+
+Usage:
+    .pio/build/native_bench/program --bench bench_host.json
+    python tools/bench_report.py bench_host.json
+    python tools/bench_report.py bench_host.json --baseline bench_main.json
+    pio device monitor | python tools/bench_report.py - --output bench_target.json
+
+Input is either a results file written by the host build (--bench) or a
+UART log containing the {"bench":...} lines the firmware sends for C:W;
+both are turned into the same results file (--output). With --baseline the
+best-batch time (min, the stable figure; --metric avg for the mean) of every
+benchmark is compared and the exit status is 1 when any of them got slower
+by more than --threshold percent, so the script can gate a CI job. Only
+results of the same target should be compared.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    """Results file or UART log -> {"target", "cyc_us", "results": {name: stats}}."""
+    source = sys.stdin if path == "-" else open(path, "r", errors="replace")
+    with source:
+        text = source.read()
+
+    try:
+        data = json.loads(text)
+        if isinstance(data, dict) and "results" in data:
+            return data
+    except ValueError:
+        pass
+
+    results = {}
+    cyc_us = None
+    for line in text.splitlines():
+        line = line.strip()
+        if not line.startswith('{"bench"'):
+            continue
+        try:
+            msg = json.loads(line)
+        except ValueError:
+            continue
+        cyc_us = msg["cyc_us"]
+        results[msg["bench"]] = {k: msg[k] for k in ("n", "min", "avg", "max")}
+    if not results:
+        raise SystemExit("%s: no benchmark results" % path)
+    return {"target": "stm32", "cyc_us": cyc_us, "results": results}
+
+
+def to_ns(data, name, key):
+    return data["results"][name][key] * 1000.0 / data["cyc_us"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("input", help="results file or UART log ('-' = stdin)")
+    parser.add_argument("--baseline", help="results file to compare against")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown, %% (default 10)")
+    parser.add_argument("--metric", choices=("min", "avg"), default="min",
+                        help="statistic compared with the baseline (default min)")
+    parser.add_argument("--output", help="write the results file")
+    args = parser.parse_args()
+
+    data = load_results(args.input)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(data, f, indent=1)
+            f.write("\n")
+
+    base = load_results(args.baseline) if args.baseline else None
+    regressions = 0
+
+    print("%-24s %10s %10s %10s %9s" % ("benchmark", "min ns", "avg ns", "max ns",
+                                        ("%s vs base" % args.metric) if base else ""))
+    for name in data["results"]:
+        row = "%-24s %10.0f %10.0f %10.0f" % (name, to_ns(data, name, "min"),
+                                              to_ns(data, name, "avg"), to_ns(data, name, "max"))
+        if base and name in base["results"]:
+            before = to_ns(base, name, args.metric)
+            change = (to_ns(data, name, args.metric) - before) * 100.0 / before if before else 0.0
+            row += " %+8.1f%%" % change
+            if change > args.threshold:
+                row += "  SLOWER"
+                regressions += 1
+        elif base:
+            row += " %9s" % "new"
+        print(row)
+
+    if base:
+        print("%d of %d benchmarks slower than %.0f%%" % (regressions, len(data["results"]),
+                                                          args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+Decode deferred log records ({"log":"hex"} lines) into text.
+
+Usage:
+    python tools/dlog_decode.py uart_log.txt
+    pio device monitor | python tools/dlog_decode.py -
+    python tools/dlog_decode.py --dict dlog_dict.json    # export the dictionary
+
+The input is the raw UART log; other telemetry lines are ignored (or passed
+through with --all). Message IDs and format strings are read from
+include/dlog.h (DLOG_MESSAGES), so the firmware never stores the text.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "include", "dlog.h")
+
+MESSAGE_RE = re.compile(r'X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+CONVERSION_RE = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diuxXocfFeEgGs%])")
+HEADER_WORDS = 2        # DLOG_HEADER_WORDS: id | nargs << 16, timestamp us
+
+
+def load_messages(header_path):
+    """Message table in enum order: list of (id, format)."""
+    with open(header_path, "r", encoding="utf-8") as f:
+        text = f.read()
+    start = text.find("#define DLOG_MESSAGES(X)")
+    if start < 0:
+        raise SystemExit("DLOG_MESSAGES not found in %s" % header_path)
+    end = text.find("\n\n", start)
+    return [(name, fmt.encode().decode("unicode_escape").encode("latin-1").decode("utf-8"))
+            for name, fmt in MESSAGE_RE.findall(text[start:end])]
+
+
+def format_message(fmt, args):
+    """printf-style formatting of raw 32-bit arguments."""
+    args = list(args)
+
+    def convert(match):
+        flags, kind = match.group(1), match.group(2)
+        if kind == "%":
+            return "%"
+        if not args:
+            return "<?>"
+        raw = args.pop(0)
+        if kind in "di":
+            value = raw - (1 << 32) if raw & 0x80000000 else raw
+        elif kind in "fFeEgG":
+            value = struct.unpack("<f", struct.pack("<I", raw))[0]
+        elif kind == "c":
+            value = chr(raw & 0xFF)
+        elif kind == "s":
+            return "<str>"
+        else:
+            value = raw
+        return ("%" + flags + ("d" if kind in "iu" else kind)) % value
+
+    return CONVERSION_RE.sub(convert, fmt)
+
+
+def decode_words(words, messages):
+    """Yield (time_us, name, text) for every record in a line."""
+    i = 0
+    while i + HEADER_WORDS <= len(words):
+        msg_id = words[i] & 0xFFFF
+        nargs = (words[i] >> 16) & 0xFF
+        time_us = words[i + 1]
+        args = words[i + HEADER_WORDS:i + HEADER_WORDS + nargs]
+        i += HEADER_WORDS + nargs
+        if msg_id < len(messages):
+            name, fmt = messages[msg_id]
+            yield time_us, name, format_message(fmt, args)
+        else:
+            yield time_us, "?", "unknown message %d %s" % (msg_id, " ".join("0x%X" % a for a in args))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Deferred log decoder")
+    parser.add_argument("log", nargs="?", help="captured UART log ('-' = stdin)")
+    parser.add_argument("--header", default=DEFAULT_HEADER, help="path to include/dlog.h")
+    parser.add_argument("--dict", metavar="FILE", help="write the ID -> format dictionary as JSON")
+    parser.add_argument("--all", action="store_true", help="also print other telemetry lines")
+    args = parser.parse_args()
+
+    messages = load_messages(args.header)
+
+    if args.dict:
+        with open(args.dict, "w", encoding="utf-8") as f:
+            json.dump({i: {"id": name, "format": fmt} for i, (name, fmt) in enumerate(messages)},
+                      f, indent=1, ensure_ascii=False)
+        print("%d messages -> %s" % (len(messages), args.dict), file=sys.stderr)
+        if args.log is None:
+            return 0
+
+    if args.log is None:
+        parser.error("log file required")
+
+    source = sys.stdin if args.log == "-" else open(args.log, "r", errors="replace")
+    with source:
+        for line in source:
+            line = line.strip()
+            msg = None
+            if line.startswith("{"):
+                try:
+                    msg = json.loads(line)
+                except ValueError:
+                    pass
+            if not isinstance(msg, dict) or "log" not in msg:
+                if args.all and line:
+                    print(line)
+                continue
+
+            data = bytes.fromhex(msg["log"])
+            words = struct.unpack("<%dI" % (len(data) // 4), data[:len(data) // 4 * 4])
+            for time_us, name, text in decode_words(words, messages):
+                print("[%12.6f] %s" % (time_us / 1e6, text))
+            sys.stdout.flush()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+Static RAM usage by module from a GNU ld map file.
+
+Usage:
+    python tools/ram_report.py .pio/build/blackpill_f411ce/firmware.map
+    python tools/ram_report.py firmware.map --symbols 20
+
+The map file is written by the -Wl,-Map flag in platformio.ini. Input
+sections .data*, .bss* and COMMON are summed per object file; with
+-fdata-sections (PlatformIO default) every variable has its own section,
+so --symbols lists the largest variables.
+"""
+
+import argparse
+import os
+import re
+import sys
+from collections import defaultdict
+
+RAM_SECTIONS = ("data", "bss")
+
+# " .bss.telemetry_buffer  0x20000a10  0x100 path/uart_telemetry.o"
+# Long section names put address/size/file on the following line.
+SECTION_RE = re.compile(r"^ (\.(data|bss)(\.\S*)?|COMMON)(\s+0x[0-9a-fA-F]+\s+0x[0-9a-fA-F]+\s+\S.*)?$")
+PLACEMENT_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def module_name(path):
+    """uart_telemetry.o, or libc_nano.a(lib_a-mallocr.o) for archive members."""
+    path = path.strip()
+    match = re.match(r"(.*\.a)\((.*)\)$", path)
+    if match:
+        return "%s(%s)" % (os.path.basename(match.group(1)), match.group(2))
+    return os.path.basename(path)
+
+
+def parse_map(lines):
+    """Return list of (kind, symbol, size, module) for RAM input sections."""
+    entries = []
+    in_memory_map = False
+    pending = None
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if line.startswith("Linker script and memory map"):
+            in_memory_map = True
+            continue
+        if not in_memory_map:
+            continue
+
+        if pending is not None:
+            placement = PLACEMENT_RE.match(line)
+            if placement:
+                kind, symbol = pending
+                entries.append((kind, symbol, int(placement.group(2), 16),
+                                module_name(placement.group(3))))
+            pending = None
+            continue
+
+        match = SECTION_RE.match(line)
+        if not match:
+            continue
+
+        name = match.group(1)
+        kind = "bss" if name == "COMMON" else match.group(2)
+        symbol = (match.group(3) or "")[1:] or name
+        if match.group(4):
+            placement = PLACEMENT_RE.match(match.group(4))
+            if placement:
+                entries.append((kind, symbol, int(placement.group(2), 16),
+                                module_name(placement.group(3))))
+        else:
+            pending = (kind, symbol)
+
+    return entries
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Static RAM usage by module")
+    parser.add_argument("map_file", help="GNU ld map file")
+    parser.add_argument("--symbols", type=int, default=0, metavar="N",
+                        help="also list the N largest variables")
+    args = parser.parse_args()
+
+    with open(args.map_file, "r", errors="replace") as f:
+        entries = parse_map(f)
+
+    if not entries:
+        print("No .data/.bss input sections found in %s" % args.map_file, file=sys.stderr)
+        return 1
+
+    modules = defaultdict(lambda: {kind: 0 for kind in RAM_SECTIONS})
+    for kind, _, size, module in entries:
+        modules[module][kind] += size
+
+    rows = sorted(modules.items(), key=lambda item: -sum(item[1].values()))
+    total = {kind: sum(m[kind] for m in modules.values()) for kind in RAM_SECTIONS}
+
+    print("%-40s %8s %8s %8s" % ("module", "data", "bss", "total"))
+    for module, sizes in rows:
+        if sum(sizes.values()) == 0:
+            continue
+        print("%-40s %8d %8d %8d" % (module, sizes["data"], sizes["bss"], sum(sizes.values())))
+    print("%-40s %8d %8d %8d" % ("TOTAL", total["data"], total["bss"], sum(total.values())))
+
+    if args.symbols > 0:
+        print()
+        print("%-40s %-6s %8s  %s" % ("symbol", "kind", "size", "module"))
+        largest = sorted(entries, key=lambda e: -e[2])[:args.symbols]
+        for kind, symbol, size, module in largest:
+            print("%-40s %-6s %8d  %s" % (symbol, kind, size, module))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,327 @@
+#!/usr/bin/env python3
+"""
+Record, inspect and compare command/telemetry sessions (session files).
+
+Usage:
+    python tools/session.py record /dev/ttyUSB0 -o field.rec      # type commands, Ctrl+D ends
+    python tools/session.py record /tmp/blackpill -o run.rec < commands.txt
+    python tools/session.py extract uart_log.txt -o field.rec      # firmware dump (C:G)
+    python tools/session.py show field.rec
+    .pio/build/native/program --replay field.rec --record replay.rec
+    python tools/session.py diff field.rec replay.rec --ignore rpm,duty
+
+A session file is an 8-byte header ("BPRC", version 1) followed by records:
+u32 time_us, u8 direction (0 = command in, 1 = telemetry out), u8 length,
+the line (see include/recorder.h). Sources:
+  - the firmware built with -DUSE_RECORDER keeps the last ~4 KB in a ring;
+    "C:G" dumps it as {"rec":...} / {"rd":"hex"} lines, "extract" turns the
+    UART log into a session file
+  - "record" talks to a serial port or the host build's pty and stamps
+    both directions with the host clock; input lines are sent as they are
+    read, "wait <ms>" lines pause
+  - the host build writes one with --record (virtual time)
+
+"diff" compares the telemetry lines of two sessions in order (difflib),
+reports added/missing/changed lines, the time shift of matching lines and
+the command-to-first-reply latency of both; exit status 1 if they differ.
+--ignore drops JSON keys whose values legitimately differ (measurements).
+"""
+
+import argparse
+import difflib
+import json
+import os
+import select
+import struct
+import sys
+import termios
+import time
+
+MAGIC = b"BPRC"
+VERSION = 1
+HEADER = MAGIC + bytes([VERSION, 0, 0, 0])
+RECORD_HEADER = struct.Struct("<IBB")
+DIR_IN, DIR_OUT = 0, 1
+MAX_LINE = 255
+
+
+def parse_records(data):
+    """Record bytes -> list of (time_us, dir, line), time unwrapped (u32 us)."""
+    records = []
+    pos = 0
+    base = 0
+    prev = None
+    while pos + RECORD_HEADER.size <= len(data):
+        t, direction, length = RECORD_HEADER.unpack_from(data, pos)
+        pos += RECORD_HEADER.size
+        if pos + length > len(data):
+            break
+        line = data[pos:pos + length].decode("utf-8", "replace")
+        pos += length
+        if prev is not None and t < prev and prev - t > 1 << 31:
+            base += 1 << 32
+        prev = t
+        records.append((base + t, direction, line))
+    return records
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != MAGIC or data[4] != VERSION:
+        raise SystemExit("%s: not a session file" % path)
+    return parse_records(data[len(HEADER):])
+
+
+def encode(time_us, direction, line):
+    raw = line.encode("utf-8")[:MAX_LINE]
+    return RECORD_HEADER.pack(time_us & 0xFFFFFFFF, direction, len(raw)) + raw
+
+
+# ============================================================================
+# record / extract / show
+# ============================================================================
+
+def open_port(path, baud):
+    """Raw 8N1 serial port, non-blocking."""
+    speeds = {9600: termios.B9600, 57600: termios.B57600, 115200: termios.B115200,
+              230400: termios.B230400}
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    attrs = termios.tcgetattr(fd)
+    attrs[0] = attrs[1] = attrs[3] = 0
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attrs[4] = attrs[5] = speeds[baud]
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def cmd_record(args):
+    fd = open_port(args.port, args.baud)
+    start = time.monotonic()
+    now_us = lambda: int((time.monotonic() - start) * 1e6)
+    out = open(args.output, "wb")
+    out.write(HEADER)
+    counts = [0, 0]
+
+    def write(direction, line):
+        out.write(encode(now_us(), direction, line))
+        counts[direction] += 1
+        if args.echo:
+            print("%s %s" % ("<" if direction == DIR_OUT else ">", line))
+
+    stdin_open = True
+    resume = 0.0            # "wait": stdin is not read before this time
+    stop = None             # End of the tail after the last input line
+    buf = b""
+    try:
+        while stop is None or time.monotonic() < stop:
+            inputs = [fd]
+            if stdin_open and time.monotonic() >= resume:
+                inputs.append(sys.stdin)
+            ready, _, _ = select.select(inputs, [], [], 0.05)
+
+            if fd in ready:
+                buf += os.read(fd, 4096)
+                while b"\n" in buf:
+                    line, buf = buf.split(b"\n", 1)
+                    write(DIR_OUT, line.decode("utf-8", "replace").rstrip("\r"))
+
+            if sys.stdin in ready:
+                line = sys.stdin.readline()
+                if not line:
+                    stdin_open = False
+                    stop = time.monotonic() + args.tail
+                    continue
+                line = line.strip()
+                if not line or line.startswith("#"):
+                    continue
+                if line.startswith("wait "):
+                    resume = time.monotonic() + float(line[5:]) / 1000.0
+                    continue
+                os.write(fd, (line + "\n").encode())
+                write(DIR_IN, line)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        out.close()
+        os.close(fd)
+    print("%d commands, %d telemetry lines -> %s" % (counts[DIR_IN], counts[DIR_OUT], args.output),
+          file=sys.stderr)
+    return 0
+
+
+def cmd_extract(args):
+    """Firmware dump lines -> session file (the last complete dump in the log)."""
+    data = None
+    expected = lost = 0
+    dump = None
+    with (sys.stdin if args.log == "-" else open(args.log, "r", errors="replace")) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                msg = json.loads(line)
+            except ValueError:
+                continue
+            if msg.get("rec") == "begin":
+                dump, expected, lost = bytearray(), msg["n"], msg["lost"]
+            elif "rd" in msg and dump is not None:
+                dump += bytes.fromhex(msg["rd"])
+            elif msg.get("rec") == "end" and dump is not None:
+                data, dump = bytes(dump), None
+
+    if data is None:
+        raise SystemExit("%s: no complete recorder dump (send C:G)" % args.log)
+    if len(data) != expected:
+        print("warning: %d bytes received, %d announced" % (len(data), expected), file=sys.stderr)
+
+    records = parse_records(data)
+    with open(args.output, "wb") as out:
+        out.write(HEADER)
+        out.write(data)
+    print("%d records (%d lost before the dump) -> %s" % (len(records), lost, args.output),
+          file=sys.stderr)
+    return 0
+
+
+def cmd_show(args):
+    records = load(args.session)
+    t0 = records[0][0] if records else 0
+    for t, direction, line in records:
+        if args.commands and direction != DIR_IN:
+            continue
+        print("%12.6f %s %s" % ((t - t0) / 1e6, ">" if direction == DIR_IN else "<", line))
+    return 0
+
+
+# ============================================================================
+# diff
+# ============================================================================
+
+def normalize(line, ignore):
+    """Line with the ignored keys' values blanked, for comparison."""
+    if not ignore:
+        return line
+    try:
+        msg = json.loads(line)
+    except ValueError:
+        return line
+
+    def strip(value):
+        if isinstance(value, dict):
+            return {k: ("~" if k in ignore else strip(v)) for k, v in value.items()}
+        if isinstance(value, list):
+            return [strip(v) for v in value]
+        return value
+
+    return json.dumps(strip(msg), sort_keys=False)
+
+
+def reply_latencies(records):
+    """Command -> first telemetry line after it, us."""
+    latencies = []
+    pending = None
+    for t, direction, _ in records:
+        if direction == DIR_IN:
+            pending = t
+        elif pending is not None:
+            latencies.append(t - pending)
+            pending = None
+    return latencies
+
+
+def summary(values):
+    if not values:
+        return "-"
+    return "avg %.0f / max %.0f us (n=%d)" % (sum(values) / len(values), max(values), len(values))
+
+
+def cmd_diff(args):
+    ignore = set(k for k in (args.ignore or "").split(",") if k)
+    a, b = load(args.a), load(args.b)
+    ta0 = a[0][0] if a else 0
+    tb0 = b[0][0] if b else 0
+
+    a_out = [(t - ta0, line) for t, d, line in a if d == DIR_OUT]
+    b_out = [(t - tb0, line) for t, d, line in b if d == DIR_OUT]
+    a_key = [normalize(line, ignore) for _, line in a_out]
+    b_key = [normalize(line, ignore) for _, line in b_out]
+
+    a_cmd = [line for _, d, line in a if d == DIR_IN]
+    b_cmd = [line for _, d, line in b if d == DIR_IN]
+    if a_cmd != b_cmd:
+        print("commands differ: %d vs %d lines" % (len(a_cmd), len(b_cmd)))
+
+    matcher = difflib.SequenceMatcher(None, a_key, b_key, autojunk=False)
+    shifts = []
+    shown = 0
+    missing = added = 0
+    for op, i1, i2, j1, j2 in matcher.get_opcodes():
+        if op == "equal":
+            shifts += [b_out[j][0] - a_out[i][0] for i, j in zip(range(i1, i2), range(j1, j2))]
+            continue
+        if op in ("replace", "delete"):
+            missing += i2 - i1
+        if op in ("replace", "insert"):
+            added += j2 - j1
+        if shown < args.context:
+            for i in range(i1, i2):
+                print("- %10.6f %s" % (a_out[i][0] / 1e6, a_out[i][1]))
+            for j in range(j1, j2):
+                print("+ %10.6f %s" % (b_out[j][0] / 1e6, b_out[j][1]))
+            shown += 1
+
+    equal = len(shifts)
+    abs_shift = [abs(s) for s in shifts]
+    print("telemetry: %d / %d lines match, %d only in %s, %d only in %s" %
+          (equal, max(len(a_out), len(b_out)), missing, args.a, added, args.b))
+    if shifts:
+        print("time shift of matching lines: avg %+.0f us, max |%.0f| us" %
+              (sum(shifts) / len(shifts), max(abs_shift)))
+    print("reply latency %s: %s" % (args.a, summary(reply_latencies(a))))
+    print("reply latency %s: %s" % (args.b, summary(reply_latencies(b))))
+
+    differs = missing or added or (args.max_shift is not None and abs_shift and
+                                   max(abs_shift) > args.max_shift)
+    return 1 if differs else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("record", help="capture a live session from a serial port / pty")
+    p.add_argument("port")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--baud", type=int, default=115200)
+    p.add_argument("--tail", type=float, default=1.0,
+                   help="keep recording this long after the end of input, s")
+    p.add_argument("--echo", action="store_true", help="print the traffic")
+    p.set_defaults(func=cmd_record)
+
+    p = sub.add_parser("extract", help="session file from a UART log with a C:G dump")
+    p.add_argument("log", help="UART log ('-' = stdin)")
+    p.add_argument("-o", "--output", required=True)
+    p.set_defaults(func=cmd_extract)
+
+    p = sub.add_parser("show", help="print a session")
+    p.add_argument("session")
+    p.add_argument("--commands", action="store_true", help="commands only")
+    p.set_defaults(func=cmd_show)
+
+    p = sub.add_parser("diff", help="compare the telemetry of two sessions")
+    p.add_argument("a")
+    p.add_argument("b")
+    p.add_argument("--ignore", help="comma-separated JSON keys whose values are not compared")
+    p.add_argument("--context", type=int, default=10, help="difference blocks to print")
+    p.add_argument("--max-shift", type=float,
+                   help="also fail when a matching line moved more than this, us")
+    p.set_defaults(func=cmd_diff)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+Convert a captured "C:Y" trace dump into Chrome trace / Perfetto JSON.
+
+Usage:
+    python tools/trace2perfetto.py uart_log.txt -o trace.json
+    # open trace.json in https://ui.perfetto.dev or chrome://tracing
+
+The input is the raw UART log (other telemetry lines are ignored). Event
+IDs, kinds and tracks are read from include/trace.h (TRACE_EVENTS), task
+names from the {"task":...} lines sent at the start of the dump.
+
+Record timestamps are microseconds of the TIM5 timebase. Dumps from older
+firmware carry "cyc_us" in the "begin" line; their timestamps are DWT
+cycles and are divided by it.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "include", "trace.h")
+
+EVENT_RE = re.compile(r'X\(\s*(\w+)\s*,\s*TRACE_(INSTANT|BEGIN|END)\s*,\s*"([^"]+)"\s*,\s*"([^"]+)"\s*\)')
+RECORD = struct.Struct("<IHHI")     # timestamp (us), event, arg0, arg1 (Trace_Entry)
+
+BUTTON_EVENTS = ["press", "release", "long", "chord"]
+MOTOR_DIRECTIONS = ["stop", "forward", "reverse", "brake"]
+
+
+def load_events(header_path):
+    """Event table in enum order: list of (id, kind, name, track)."""
+    with open(header_path, "r") as f:
+        text = f.read()
+    start = text.find("#define TRACE_EVENTS(X)")
+    if start < 0:
+        raise SystemExit("TRACE_EVENTS not found in %s" % header_path)
+    end = text.find("\n\n", start)
+    return EVENT_RE.findall(text[start:end])
+
+
+def read_dumps(lines):
+    """Yield (records, ticks_per_us, lost, task_names) for every dump in the log."""
+    task_names = {}
+    records = None
+    ticks_per_us = 1
+    lost = 0
+
+    for line in lines:
+        line = line.strip()
+        if not line.startswith("{"):
+            continue
+        try:
+            msg = json.loads(line)
+        except ValueError:
+            continue
+
+        if "task" in msg and "name" in msg:
+            task_names[msg["task"]] = msg["name"]
+        elif msg.get("trace") == "begin":
+            records = []
+            ticks_per_us = max(1, int(msg.get("cyc_us", 1)))   # Absent: us
+            lost = int(msg.get("lost", 0))
+        elif "tr" in msg and records is not None:
+            data = bytes.fromhex(msg["tr"])
+            for offset in range(0, len(data) - RECORD.size + 1, RECORD.size):
+                records.append(RECORD.unpack_from(data, offset))
+        elif msg.get("trace") == "end" and records is not None:
+            yield records, ticks_per_us, lost, dict(task_names)
+            records = None
+
+
+def describe(name, arg0, arg1, task_names):
+    """Human-readable arguments of an event."""
+    if name == "task":
+        return task_names.get(arg0, "task %d" % arg0), {"us": arg1}
+    if name == "command":
+        return "command %s" % (chr(arg0) if 32 <= arg0 < 127 else arg0), {}
+    if name == "button":
+        kind = BUTTON_EVENTS[arg0] if arg0 < len(BUTTON_EVENTS) else str(arg0)
+        return "button %d %s" % (arg1 & 0xFF, kind), {"held": "0x%X" % (arg1 >> 8)}
+    if name == "motor":
+        direction = arg1 >> 8
+        label = MOTOR_DIRECTIONS[direction] if direction < len(MOTOR_DIRECTIONS) else str(direction)
+        return "motor %d" % arg0, {"dir": label, "speed": arg1 & 0xFF}
+    if name == "notify":
+        return "notify %s" % task_names.get(arg0, arg0), {}
+    return name, {"arg0": arg0, "arg1": arg1}
+
+
+def convert(dump, events, pid):
+    records, ticks_per_us, lost, task_names = dump
+    tracks = {}
+    depth = {}
+    out = []
+    base = None
+    last = None
+    wraps = 0
+
+    for timestamp, event, arg0, arg1 in records:
+        # Unwrap the 32-bit timestamp (records are in time order)
+        if last is not None and timestamp < last:
+            wraps += 1
+        last = timestamp
+        ticks = timestamp + (wraps << 32)
+        if base is None:
+            base = ticks
+        ts = (ticks - base) / ticks_per_us
+
+        if event >= len(events):
+            continue
+        _, kind, name, track = events[event]
+        if track not in tracks:
+            tracks[track] = len(tracks) + 1
+            depth[track] = 0
+        tid = tracks[track]
+        label, args = describe(name, arg0, arg1, task_names)
+
+        if kind == "BEGIN":
+            depth[track] += 1
+            out.append({"name": label, "ph": "B", "ts": ts, "pid": pid, "tid": tid, "args": args})
+        elif kind == "END":
+            if depth[track] == 0:
+                continue        # Its BEGIN was overwritten in the ring
+            depth[track] -= 1
+            out.append({"name": label, "ph": "E", "ts": ts, "pid": pid, "tid": tid, "args": args})
+        else:
+            out.append({"name": label, "ph": "i", "s": "t", "ts": ts, "pid": pid, "tid": tid,
+                        "args": args})
+
+    out.append({"name": "process_name", "ph": "M", "pid": pid,
+                "args": {"name": "dump %d (%d lost)" % (pid, lost)}})
+    for track, tid in tracks.items():
+        out.append({"name": "thread_name", "ph": "M", "pid": pid, "tid": tid,
+                    "args": {"name": track}})
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Trace dump to Chrome trace / Perfetto JSON")
+    parser.add_argument("log", help="captured UART log ('-' = stdin)")
+    parser.add_argument("-o", "--output", default="-", help="output JSON file (default stdout)")
+    parser.add_argument("--header", default=DEFAULT_HEADER, help="path to include/trace.h")
+    args = parser.parse_args()
+
+    events = load_events(args.header)
+    source = sys.stdin if args.log == "-" else open(args.log, "r", errors="replace")
+    with source:
+        dumps = list(read_dumps(source))
+
+    if not dumps:
+        print("No complete trace dump found", file=sys.stderr)
+        return 1
+
+    trace = {"traceEvents": [], "displayTimeUnit": "ns"}
+    for pid, dump in enumerate(dumps, start=1):
+        trace["traceEvents"].extend(convert(dump, events, pid))
+
+    text = json.dumps(trace, indent=1)
+    if args.output == "-":
+        print(text)
+    else:
+        with open(args.output, "w") as f:
+            f.write(text)
+        print("%d dump(s), %d events -> %s" % (len(dumps), len(trace["traceEvents"]), args.output),
+              file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
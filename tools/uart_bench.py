@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Command throughput, drop rate and round-trip latency over the serial link.
+
+Usage:
+    .pio/build/native/program --pty /tmp/blackpill &
+    python tools/uart_bench.py /tmp/blackpill
+    python tools/uart_bench.py /tmp/blackpill --count 500 --rate 50
+    python tools/uart_bench.py /dev/ttyUSB0 --baud 115200 --command C:E --reply encoder
+
+Sends --count commands and waits for the telemetry line whose first key is
+--reply (C:I answers {"idle":...}). With --rate 0 (default) the next command
+goes out as soon as the previous reply arrives; with --rate N commands are
+sent N per second regardless of replies, and replies are matched to the
+oldest unanswered command. A command without a reply within --timeout is
+counted as dropped. Other telemetry lines are counted but not matched.
+
+Works on the board's serial port and on the host build's pty (--pty); the
+host build also prints its own view of the link to stderr when stopped.
+"""
+
+import argparse
+import json
+import os
+import select
+import sys
+import termios
+import time
+from collections import deque
+
+BAUD_RATES = {9600: termios.B9600, 19200: termios.B19200, 38400: termios.B38400,
+              57600: termios.B57600, 115200: termios.B115200, 230400: termios.B230400}
+
+
+def open_port(path, baud):
+    """Raw 8N1 serial port, non-blocking."""
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    attrs = termios.tcgetattr(fd)
+    attrs[0] = 0                                            # iflag
+    attrs[1] = 0                                            # oflag
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL  # cflag
+    attrs[3] = 0                                            # lflag
+    attrs[4] = attrs[5] = BAUD_RATES[baud]
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    termios.tcflush(fd, termios.TCIOFLUSH)
+    return fd
+
+
+def first_key(line):
+    """First JSON key of a telemetry line, None for anything else."""
+    try:
+        msg = json.loads(line)
+    except ValueError:
+        return None
+    if isinstance(msg, dict) and msg:
+        return next(iter(msg))
+    return None
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(round(p / 100.0 * (len(values) - 1))))]
+
+
+def run(fd, args):
+    command = (args.command + "\n").encode()
+    interval = 1.0 / args.rate if args.rate > 0 else 0.0
+    pending = deque()          # send times of unanswered commands
+    latencies = []
+    sent = dropped = other = 0
+    buf = b""
+
+    start = time.monotonic()
+    next_send = start
+    while sent < args.count or pending:
+        now = time.monotonic()
+
+        while pending and now - pending[0] > args.timeout:
+            pending.popleft()
+            dropped += 1
+
+        can_send = sent < args.count and (not pending if interval == 0 else now >= next_send)
+        if can_send:
+            os.write(fd, command)
+            pending.append(time.monotonic())
+            sent += 1
+            next_send += interval
+            continue
+
+        wait = args.timeout if interval == 0 else max(0.0, min(next_send - now, args.timeout))
+        if sent >= args.count and pending:
+            wait = max(0.0, pending[0] + args.timeout - now)
+        ready, _, _ = select.select([fd], [], [], wait)
+        if not ready:
+            continue
+
+        buf += os.read(fd, 4096)
+        while b"\n" in buf:
+            line, buf = buf.split(b"\n", 1)
+            key = first_key(line.decode("utf-8", "replace").strip())
+            if key == args.reply and pending:
+                latencies.append((time.monotonic() - pending.popleft()) * 1e6)
+            else:
+                other += 1
+
+    elapsed = time.monotonic() - start
+    answered = len(latencies)
+    return {
+        "command": args.command,
+        "sent": sent,
+        "answered": answered,
+        "dropped": dropped,
+        "drop_pct": round(100.0 * dropped / sent, 2) if sent else 0.0,
+        "other_lines": other,
+        "elapsed_s": round(elapsed, 3),
+        "throughput_cmd_s": round(answered / elapsed, 1) if elapsed > 0 else 0.0,
+        "latency_us": {
+            "min": round(min(latencies)) if latencies else 0,
+            "avg": round(sum(latencies) / answered) if latencies else 0,
+            "p50": round(percentile(latencies, 50)),
+            "p99": round(percentile(latencies, 99)),
+            "max": round(max(latencies)) if latencies else 0,
+        },
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("port", help="serial device or pty (symlink from --pty)")
+    parser.add_argument("--baud", type=int, default=115200, choices=sorted(BAUD_RATES))
+    parser.add_argument("--command", default="C:I", help="command to send (default C:I)")
+    parser.add_argument("--reply", default="idle", help="first JSON key of the reply (default idle)")
+    parser.add_argument("--count", type=int, default=200, help="commands to send")
+    parser.add_argument("--rate", type=float, default=0.0,
+                        help="commands per second, 0 = after each reply (default)")
+    parser.add_argument("--timeout", type=float, default=1.0, help="reply timeout, s")
+    parser.add_argument("--settle", type=float, default=0.2,
+                        help="drain the port this long before starting, s")
+    args = parser.parse_args()
+
+    fd = open_port(args.port, args.baud)
+    try:
+        end = time.monotonic() + args.settle
+        while time.monotonic() < end:
+            if select.select([fd], [], [], max(0.0, end - time.monotonic()))[0]:
+                os.read(fd, 4096)
+        print(json.dumps(run(fd, args)))
+    finally:
+        os.close(fd)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())